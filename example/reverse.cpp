@@ -60,8 +60,7 @@ END_PROPERTY_TYPE
 
 int main(int argc, char* argv[])
 {
-    (void)argc;
-    (void)argv;
+    qcxx::configure(argc, argv);
     
     qcxx::quickCheck<prop_DoubleReverse>();
     qcxx::quickCheck<prop_IdenticalReverse>();
@@ -34,21 +34,67 @@
 #define QCXX_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <deque>
 #include <exception>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
 #include <random>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(__linux__) && !defined(QCXX_SKIP_PERF_COUNTERS)
+#define QCXX_HAVE_PERF_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(QCXX_SKIP_FORK)
+#define QCXX_HAVE_FORK
+#include <csignal>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(__cpp_impl_coroutine) && !defined(QCXX_SKIP_COROUTINES)
+#define QCXX_HAVE_COROUTINES
+#include <coroutine>
+#include <optional>
+#endif
+
 #define QCXX_THROW_(_E, _F, _L, _S)                                         \
     throw _E(_F "[" #_L "]:" _S)
 
@@ -57,7 +103,8 @@
 
 namespace qcxx {
 
-typedef unsigned int size_type;
+typedef std::uint64_t size_type;
+typedef unsigned long long seed_type;
 
 /* Default minimizer for non-specialized types. Every minimizer
  * must produce a list of at least one value, if it can not
@@ -228,6 +275,75 @@ get_generator(
     >::generator_type(engine);
 }
 
+/* Specialize this template, preferably using %ENUMERABLE_TYPE,
+ * for types whose values can be listed in order of increasing
+ * size, up to a depth. Such types can be tested exhaustively.
+ */
+template
+<
+    typename Type
+>
+class enumerable;
+
+/* Create a specialization for the enumerable template using
+ * the given %Enumerator and %Type.
+ */
+#define ENUMERABLE_TYPE(_Enumerator, _Type)                                 \
+    template                                                                \
+    <                                                                       \
+    >                                                                       \
+    class enumerable<                                                       \
+        _Type                                                               \
+    > {                                                                     \
+    public:                                                                 \
+        typedef _Enumerator<                                                \
+            _Type                                                           \
+        > enumerator_type;                                                  \
+    }
+
+/**
+ * %is_enumerable
+ * @{
+ */
+template
+<
+    typename Type,
+    typename = void
+>
+struct is_enumerable :
+    std::false_type
+{};
+template
+<
+    typename Type
+>
+struct is_enumerable<
+    Type,
+    decltype((void)sizeof(typename enumerable<Type>::enumerator_type))
+> :
+    std::true_type
+{};
+/**
+ * @}
+ */
+
+/* Get an enumerator for the given %Type and %depth.
+ */
+template
+<
+    typename Type
+>
+typename enumerable<
+    Type
+>::enumerator_type
+get_enumerator(
+    const size_type& depth
+) {
+    return typename enumerable<
+        Type
+    >::enumerator_type(depth);
+}
+
 /* Base class template for value generators.
  */
 template
@@ -283,7 +399,9 @@ private:
 
 /* Generate uniform distributions of integral or floating point
  * values, possibly within a given range, otherwise within the
- * limits of the given type.
+ * limits of the given type. Real ranges too wide to be handled
+ * by %Uniform, like lowest() to max(), are halved and the value
+ * scaled back, which is exact.
  */
 template
 <
@@ -325,11 +443,11 @@ public:
             "Type/Uniform mismatch"
         );
         
-        Uniform<
-            Type
-        > distribution(min, max);
-        
-        return distribution(this->engine());
+        return this->distribute(
+            min,
+            max,
+            std::is_floating_point<Type>()
+        );
     }
     
     virtual Type
@@ -347,11 +465,52 @@ public:
         void
     ) {
         return (*this)(
-            std::numeric_limits<Type>::min(),
+            std::numeric_limits<Type>::lowest(),
             std::numeric_limits<Type>::max()
         );
     }
     
+protected:
+    /**
+     * %distribute()
+     * @{
+     */
+    Type
+    distribute(
+        const Type& min,
+        const Type& max,
+        std::false_type
+    ) {
+        Uniform<
+            Type
+        > distribution(min, max);
+        
+        return distribution(this->engine());
+    }
+    Type
+    distribute(
+        const Type& min,
+        const Type& max,
+        std::true_type
+    ) {
+        if (std::isfinite(max - min)) {
+            Uniform<
+                Type
+            > distribution(min, max);
+            
+            return distribution(this->engine());
+        }
+        
+        Uniform<
+            Type
+        > distribution(min / 2, max / 2);
+        
+        return distribution(this->engine()) * 2;
+    }
+    /**
+     * @}
+     */
+    
 };
 
 /* Generate uniform integral values.
@@ -382,6 +541,337 @@ using uniform_real_generator = uniform_numeric_generator
     std::uniform_real_distribution
 >;
 
+/* Settings for the edge biased generators. A generated value
+ * is one of the edge cases of its type with probability %rate.
+ * Otherwise, a real value is made of uniformly random bits with
+ * probability %bits_rate, spreading the values evenly over all
+ * exponents. NaN and infinities are only generated if
+ * %non_finite is true.
+ */
+struct edge_config
+{
+    edge_config(
+        void
+    ) :
+        rate(0.25),
+        bits_rate(0.25),
+        non_finite(true)
+    {}
+    
+    double rate;
+    double bits_rate;
+    bool non_finite;
+};
+
+/* The settings used by the edge biased generators when none are
+ * given explicitly.
+ */
+inline edge_config&
+edge_settings(
+    void
+) {
+    static edge_config conf;
+    return conf;
+}
+
+/* The edge cases of %Integral types: zero, plus and minus one,
+ * the limits and their neighbours, and all powers of two and
+ * their neighbours.
+ */
+template
+<
+    typename Type
+>
+std::vector<Type>
+edge_values(
+    std::false_type
+) {
+    typedef std::numeric_limits<Type> limits;
+    
+    std::vector<Type> xs = {
+        0,
+        1,
+        limits::min(),
+        static_cast<Type>(limits::min() + 1),
+        limits::max(),
+        static_cast<Type>(limits::max() - 1)
+    };
+    for (int i = 1; i < limits::digits; ++i) {
+        auto x = static_cast<Type>(Type(1) << i);
+        xs.push_back(x);
+        xs.push_back(static_cast<Type>(x - 1));
+        xs.push_back(static_cast<Type>(x + 1));
+        if (limits::is_signed) {
+            xs.push_back(static_cast<Type>(-x));
+            xs.push_back(static_cast<Type>(-x + 1));
+        }
+    }
+    if (limits::is_signed)
+        xs.push_back(static_cast<Type>(-1));
+    
+    return xs;
+}
+
+/* The edge cases of %Real types: signed zeros, plus and minus
+ * one and a half, the limits, subnormals, epsilon, the integers
+ * where precision runs out, powers of two near common integer
+ * limits, and optionally NaN and infinities.
+ */
+template
+<
+    typename Type
+>
+std::vector<Type>
+edge_values(
+    std::true_type
+) {
+    typedef std::numeric_limits<Type> limits;
+    
+    std::vector<Type> xs = {
+        limits::min(),
+        limits::denorm_min(),
+        limits::max(),
+        limits::epsilon(),
+        1 + limits::epsilon(),
+        1 - limits::epsilon() / 2,
+        std::nextafter(limits::min(), Type(0)),
+        std::ldexp(Type(1), limits::digits),
+        std::ldexp(Type(1), limits::digits) + 2,
+        std::ldexp(Type(1), limits::digits) - 1
+    };
+    for (auto e : {7, 8, 15, 16, 31, 32, 63, 64})
+        xs.push_back(std::ldexp(Type(1), e));
+    for (auto x : {0.0, 0.5, 1.0, 2.0})
+        xs.push_back(static_cast<Type>(x));
+    
+    for (std::size_t i = 0, n = xs.size(); i < n; ++i)
+        xs.push_back(-xs[i]);
+    
+    return xs;
+}
+
+/* Generate integral or floating point values biased towards the
+ * edge cases of their type, see %edge_config. Otherwise behaves
+ * like %uniform_numeric_generator.
+ */
+template
+<
+    typename Type,
+    typename Engine,
+    template
+    <
+        typename
+    >
+    class Uniform
+>
+class edge_numeric_generator :
+    public uniform_numeric_generator<
+        Type,
+        Engine,
+        Uniform
+    >
+{
+public:
+    
+    explicit
+    edge_numeric_generator(
+        Engine& engine,
+        const edge_config& conf = edge_settings()
+    ) :
+        uniform_numeric_generator<
+            Type,
+            Engine,
+            Uniform
+        >(engine),
+        conf_(conf)
+    {}
+    
+    virtual Type
+    operator()(
+        const Type& min,
+        const Type& max
+    ) {
+        if (this->coin(this->conf_.rate)) {
+            const auto& xs = edges();
+            std::uniform_int_distribution<std::size_t> distribution(
+                0, xs.size() + 1
+            );
+            auto i = distribution(this->engine());
+            if (i == xs.size())
+                return min;
+            if (i > xs.size())
+                return max;
+            auto x = xs[i];
+            if (min <= x && x <= max)
+                return x;
+            return x < min? min: max;
+        }
+        
+        return this->distribute(
+            min,
+            max,
+            std::is_floating_point<Type>()
+        );
+    }
+    
+    virtual Type
+    operator()(
+        const std::pair<Type, Type>& pair
+    ) {
+        return (*this)(
+            pair.first,
+            pair.second
+        );
+    }
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        if (this->coin(this->conf_.rate))
+            return this->edge(std::is_floating_point<Type>());
+        
+        return this->random(std::is_floating_point<Type>());
+    }
+    
+    /* All edge cases of %Type, excluding NaN and infinities.
+     */
+    static const std::vector<Type>&
+    edges(
+        void
+    ) {
+        static const std::vector<Type> xs = edge_values<Type>(
+            std::is_floating_point<Type>()
+        );
+        return xs;
+    }
+    
+private:
+    bool
+    coin(
+        const double& p
+    ) {
+        return p > 0 && std::bernoulli_distribution(p)(this->engine());
+    }
+    
+    /**
+     * %edge()
+     * @{
+     */
+    Type
+    edge(
+        std::false_type
+    ) {
+        const auto& xs = edges();
+        std::uniform_int_distribution<std::size_t> distribution(
+            0, xs.size() - 1
+        );
+        return xs[distribution(this->engine())];
+    }
+    Type
+    edge(
+        std::true_type
+    ) {
+        typedef std::numeric_limits<Type> limits;
+        
+        const auto& xs = edges();
+        const std::size_t n = this->conf_.non_finite? 3: 0;
+        std::uniform_int_distribution<std::size_t> distribution(
+            0, xs.size() + n - 1
+        );
+        auto i = distribution(this->engine());
+        
+        if (i < xs.size())
+            return xs[i];
+        if (i == xs.size())
+            return limits::quiet_NaN();
+        if (i == xs.size() + 1)
+            return limits::infinity();
+        return -limits::infinity();
+    }
+    /**
+     * @}
+     */
+    
+    /**
+     * %random()
+     * @{
+     */
+    Type
+    random(
+        std::false_type
+    ) {
+        return this->distribute(
+            std::numeric_limits<Type>::lowest(),
+            std::numeric_limits<Type>::max(),
+            std::false_type()
+        );
+    }
+    Type
+    random(
+        std::true_type
+    ) {
+        typedef typename std::conditional<
+            sizeof(Type) == sizeof(std::uint32_t),
+            std::uint32_t,
+            std::uint64_t
+        >::type bits_type;
+        
+        static_assert(sizeof(Type) == sizeof(bits_type),
+            "given Type has no integral type of the same size");
+        
+        if (this->coin(this->conf_.bits_rate)) {
+            std::uniform_int_distribution<bits_type> distribution;
+            for (;;) {
+                bits_type bits = distribution(this->engine());
+                Type x;
+                std::memcpy(&x, &bits, sizeof(x));
+                if (this->conf_.non_finite || std::isfinite(x))
+                    return x;
+            }
+        }
+        
+        return this->distribute(
+            std::numeric_limits<Type>::lowest(),
+            std::numeric_limits<Type>::max(),
+            std::true_type()
+        );
+    }
+    /**
+     * @}
+     */
+    
+    edge_config conf_;
+};
+
+/* Generate edge biased integral values.
+ */
+template
+<
+    typename Integral,
+    typename Engine
+>
+using edge_integral_generator = edge_numeric_generator
+<
+    Integral,
+    Engine,
+    std::uniform_int_distribution
+>;
+
+/* Generate edge biased real values.
+ */
+template
+<
+    typename Real,
+    typename Engine
+>
+using edge_real_generator = edge_numeric_generator
+<
+    Real,
+    Engine,
+    std::uniform_real_distribution
+>;
+
 /* Generate containers filled with arbitrary values. The given
  * container must have a %push_back() method.
  */
@@ -428,11 +918,280 @@ public:
     
 };
 
-/* Shrink an %Integral value to zero.
+/* The characters of the byte buffers generated by
+ * %bytes_generator: any byte, 7-bit ASCII, printable ASCII or
+ * valid UTF-8.
+ */
+enum alphabet {
+    ALPHABET_BYTES = 0,
+    ALPHABET_ASCII = 1,
+    ALPHABET_PRINTABLE = 2,
+    ALPHABET_UTF8 = 3
+};
+
+/* Settings for %bytes_generator, buffers are at most
+ * %max_size bytes.
+ */
+struct bytes_config
+{
+    bytes_config(
+        void
+    ) :
+        chars(ALPHABET_BYTES),
+        max_size(128)
+    {}
+    
+    alphabet chars;
+    std::size_t max_size;
+};
+
+/* The settings used by the byte buffer generators when none
+ * are given explicitly.
+ */
+inline bytes_config&
+bytes_settings(
+    void
+) {
+    static bytes_config conf;
+    return conf;
+}
+
+/* The number of trailing one bits of %r.
+ */
+constexpr int
+range_bits_(
+    const unsigned long long& r
+) {
+    return r & 1? 1 + range_bits_(r >> 1): 0;
+}
+
+/* Draw a length of at most %max, whose number of bits is
+ * uniform, so that short sequences are common while long ones
+ * still are generated.
  */
 template
 <
-    typename Type,
+    typename Engine
+>
+std::size_t
+draw_length_(
+    Engine& engine,
+    const std::size_t& max
+) {
+    std::size_t bits = 0;
+    while (bits < std::numeric_limits<std::size_t>::digits && max >> bits)
+        ++bits;
+    
+    std::uniform_int_distribution<std::size_t> dk(0, bits);
+    auto k = dk(engine);
+    auto n = k < std::numeric_limits<std::size_t>::digits?
+        (std::size_t(1) << k) - 1:
+        max;
+    
+    std::uniform_int_distribution<std::size_t> dn(0, std::min(n, max));
+    return dn(engine);
+}
+
+/* Fill %n bytes at %p with random bytes, using every whole
+ * byte of each value of %engine rather than one distribution
+ * call per byte.
+ */
+template
+<
+    typename Engine
+>
+void
+fill_bytes(
+    Engine& engine,
+    unsigned char* p,
+    const std::size_t& n
+) {
+    constexpr std::size_t k = range_bits_(
+        static_cast<unsigned long long>(Engine::max() - Engine::min())) / 8;
+    
+    if (!k) {
+        std::uniform_int_distribution<unsigned int> distribution(0, 255);
+        for (std::size_t i = 0; i < n; ++i)
+            p[i] = static_cast<unsigned char>(distribution(engine));
+        return;
+    }
+    
+    std::size_t i = 0;
+    for (; i + k <= n; i += k) {
+        auto w = static_cast<unsigned long long>(engine() - Engine::min());
+        for (std::size_t j = 0; j < k; ++j, w >>= 8)
+            p[i + j] = static_cast<unsigned char>(w);
+    }
+    if (i < n) {
+        auto w = static_cast<unsigned long long>(engine() - Engine::min());
+        for (; i < n; ++i, w >>= 8)
+            p[i] = static_cast<unsigned char>(w);
+    }
+}
+
+/* Turn %n random bytes at %p into characters of %chars, in
+ * place. UTF-8 code points take one to four bytes, half of
+ * them being ASCII, and never are surrogates or overlong.
+ */
+inline void
+restrict_bytes(
+    unsigned char* p,
+    const std::size_t& n,
+    const alphabet& chars
+) {
+    auto cont = [](const unsigned char& b) -> unsigned char {
+        return 0x80 | (b & 0x3f);
+    };
+    
+    switch (chars) {
+    case ALPHABET_ASCII:
+        for (std::size_t i = 0; i < n; ++i)
+            p[i] &= 0x7f;
+        break;
+    case ALPHABET_PRINTABLE:
+        for (std::size_t i = 0; i < n; ++i)
+            p[i] = static_cast<unsigned char>(0x20 + (p[i] * 95 >> 8));
+        break;
+    case ALPHABET_UTF8:
+        for (std::size_t i = 0, m = 1; i < n; i += m) {
+            auto b = p[i];
+            m = b < 0x80? 1: 2 + ((b >> 5) & 3) % 3;
+            if (i + m > n)
+                m = 1;
+            
+            switch (m) {
+            case 1:
+                p[i] = b & 0x7f;
+                break;
+            case 2:
+                p[i] = 0xc2 + (b & 0x1f) % 30;
+                p[i + 1] = cont(p[i + 1]);
+                break;
+            case 3:
+                p[i] = 0xe0 | (b & 0x0f);
+                p[i + 1] = p[i] == 0xe0? 0xa0 | (p[i + 1] & 0x1f):
+                    p[i] == 0xed? 0x80 | (p[i + 1] & 0x1f):
+                    cont(p[i + 1]);
+                p[i + 2] = cont(p[i + 2]);
+                break;
+            default:
+                p[i] = 0xf0 + (b & 0x0f) % 5;
+                p[i + 1] = p[i] == 0xf0? 0x90 + (p[i + 1] & 0x3f) % 0x30:
+                    p[i] == 0xf4? 0x80 | (p[i + 1] & 0x0f):
+                    cont(p[i + 1]);
+                p[i + 2] = cont(p[i + 2]);
+                p[i + 3] = cont(p[i + 3]);
+                break;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * %make_bytes_()
+ * @{
+ */
+template
+<
+    typename Type
+>
+Type
+make_bytes_(
+    const std::size_t& n,
+    Type*
+) {
+    return Type(n, 0);
+}
+template
+<
+    std::size_t N
+>
+std::array<std::uint8_t, N>
+make_bytes_(
+    const std::size_t&,
+    std::array<std::uint8_t, N>*
+) {
+    return std::array<std::uint8_t, N>();
+}
+/**
+ * @}
+ */
+
+/* Generate byte buffers, %std::string, %std::vector<uint8_t>
+ * or %std::array<uint8_t, N>, filled in bulk from the engine
+ * with characters of the configured alphabet. Lengths are
+ * drawn uniformly within a random power of two up to
+ * %bytes_config::max_size, so that short buffers are common
+ * while long ones still are generated. Arrays always have
+ * their own size.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class bytes_generator :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    bytes_generator(
+        Engine& engine,
+        const bytes_config& conf = bytes_settings()
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        conf_(conf)
+    {}
+    
+    virtual Type
+    operator()(
+        const std::size_t& n
+    ) {
+        auto xs = make_bytes_(n, static_cast<Type*>(nullptr));
+        if (!xs.empty()) {
+            auto p = reinterpret_cast<unsigned char*>(&xs[0]);
+            fill_bytes(this->engine(), p, xs.size());
+            restrict_bytes(p, xs.size(), this->conf_.chars);
+        }
+        return xs;
+    }
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        return (*this)(draw_length_(this->engine(), this->conf_.max_size));
+    }
+    
+    /* The settings of the generator, to be given to the
+     * %bytes_minimizer shrinking its buffers.
+     */
+    const bytes_config&
+    config(
+        void
+    ) const {
+        return this->conf_;
+    }
+    
+private:
+    bytes_config conf_;
+};
+
+/* Shrink an %Integral value to zero.
+ */
+template
+<
+    typename Type,
     typename Engine
 >
 class integral_minimizer :
@@ -558,539 +1317,9348 @@ public:
     
 };
 
+/* Shrink a byte buffer, see %bytes_generator. Strings and
+ * vectors are truncated like by %container_minimizer, and
+ * never within a UTF-8 code point if %conf, which should be
+ * the settings of the generator, asks for UTF-8. Arrays keep
+ * their size and have their trailing bytes zeroed instead.
+ */
 template
 <
-    typename Container
+    typename Type,
+    typename Engine
 >
-void
-show_container(
-    std::ostream& out,
-    const Container& xs
-) {
-    std::ostringstream osstr;
+class bytes_minimizer :
+    public minimizer<
+        Type,
+        Engine
+    >
+{
+public:
     
-    if (!xs.empty()) {
-        auto beg = xs.begin();
-        auto it = beg;
-        auto n = xs.size() - 1;
-        std::advance(it, n);
-        std::copy(
-            beg,
-            it,
-            std::ostream_iterator<
-                typename Container::value_type
-            >(osstr, ", ")
-        );
+    explicit
+    bytes_minimizer(
+        Engine& engine,
+        const bytes_config& conf = bytes_settings()
+    ) :
+        minimizer<
+            Type,
+            Engine
+        >(engine),
+        conf_(conf)
+    {}
+    
+    virtual std::list<Type>
+    operator()(
+        const Type& x
+    ) {
+        return this->shrink_(x, static_cast<Type*>(nullptr));
+    }
+    
+private:
+    bytes_config conf_;
+    
+    template
+    <
+        typename Buffer
+    >
+    std::list<Type>
+    shrink_(
+        const Type& x,
+        Buffer*
+    ) {
+        auto min = get_minimizer<std::size_t>(this->engine());
+        auto ns = min(x.size());
+        auto utf8 = this->conf_.chars == ALPHABET_UTF8;
         
-        osstr << *xs.rbegin();
+        std::list<Type> xs;
+        for (auto n : ns) {
+            while (utf8 && n > 0 && n < x.size() && (x[n] & 0xc0) == 0x80)
+                --n;
+            if (xs.empty() || xs.back().size() != n)
+                xs.push_back(Type(x.begin(), x.begin() + n));
+        }
+        return xs;
     }
     
-    out << "["
-        << osstr.str()
-        << "]"
-        << std::endl;
-}
+    template
+    <
+        std::size_t N
+    >
+    std::list<Type>
+    shrink_(
+        const Type& x,
+        std::array<std::uint8_t, N>*
+    ) {
+        auto min = get_minimizer<std::size_t>(this->engine());
+        
+        std::list<Type> xs;
+        for (auto n : min(N)) {
+            Type y = x;
+            std::fill(y.begin() + n, y.end(), 0);
+            xs.push_back(y);
+        }
+        return xs;
+    }
+};
 
+/* Specialize this template, preferably using %SUBTREES_TYPE,
+ * for recursive types such as trees. Its static %of() method
+ * returns a pointer to the sequence container holding the
+ * direct subtrees of a value, or nullptr for leaves.
+ */
 template
 <
     typename Type
 >
-void
-show(
-    std::ostream& out,
-    const Type& x
-) {
-    out << x
-        << std::endl;
-}
+class subtrees;
 
-#define SHOWABLE_TYPE(_Type, _Show)                                         \
+/* Create a specialization for the subtrees template of %Type,
+ * whose subtrees are stored in the member %_Member.
+ */
+#define SUBTREES_TYPE(_Member, _Type)                                       \
     template                                                                \
     <                                                                       \
     >                                                                       \
-    void                                                                    \
-    show<                                                                   \
+    class subtrees<                                                         \
         _Type                                                               \
-    >(                                                                      \
-        std::ostream& out,                                                  \
-        const _Type& t                                                      \
-    ) {                                                                     \
-        _Show(out, t);                                                      \
+    > {                                                                     \
+    public:                                                                 \
+        typedef decltype(                                                   \
+            std::declval<_Type&>()._Member                                  \
+        ) container_type;                                                   \
+                                                                            \
+        static container_type*                                              \
+        of(                                                                 \
+            _Type& x                                                        \
+        ) {                                                                 \
+            return &x._Member;                                              \
+        }                                                                   \
+                                                                            \
+        static const container_type*                                        \
+        of(                                                                 \
+            const _Type& x                                                  \
+        ) {                                                                 \
+            return &x._Member;                                              \
+        }                                                                   \
     }
 
-/**
- * %show_all()
- * @{
+/* The number of nodes of a recursive value, see %subtrees.
  */
 template
 <
     typename Type
 >
-void
-show_all(
-    std::ostream& out,
+std::size_t
+subtree_size(
     const Type& x
 ) {
-    show(out, x);
+    std::size_t n = 1;
+    auto cs = subtrees<Type>::of(x);
+    if (cs)
+        for (const auto& c : *cs)
+            n += subtree_size(c);
+    return n;
 }
+
+/* Shrink a recursive value, see %subtrees, by replacing it or
+ * its subtrees with their own subtrees. The list goes down the
+ * largest subtrees to a leaf, %shrinks() gives every value one
+ * step smaller, which %property uses to shrink further.
+ * Subtrees must keep their addresses while their tree is not
+ * modified, and must be cheap to move.
+ */
 template
 <
     typename Type,
-    typename... Container
+    typename Engine
 >
-void
-show_all(
-    std::ostream& out,
-    const Type& x,
-    const Container&... xs
-) {
-    show_all(out, x);
-    show_all(out, xs...);
-}
-/**
- * @}
- */
-
-enum state {
-    TEST_FAILURE = 0,
-    TEST_SUCCESS = 1,
-    TEST_DISCARD = 2,
-    TEST_NOTHING = 3
-};
-
-class result
+class subtree_minimizer :
+    public minimizer<
+        Type,
+        Engine
+    >
 {
 public:
-    result(
-        void
-    ) :
-        s_(TEST_NOTHING)
-    {}
     
-    result(
-        const bool& s
-    ) :
-        s_(static_cast<state>(s))
-    {}
+    MINIMIZER_CTOR(subtree_minimizer)
     
-    result(
-        const state& s
-    ) :
-        s_(s)
-    {}
+    virtual std::list<Type>
+    operator()(
+        const Type& x
+    ) {
+        std::unordered_map<const Type*, std::size_t> sizes;
+        measure_(x, sizes);
+        
+        std::list<Type> xs;
+        for (auto p = &x; ; ) {
+            xs.push_back(*p);
+            auto cs = subtrees<Type>::of(*p);
+            if (!cs || cs->empty())
+                break;
+            p = &*std::max_element(
+                cs->begin(),
+                cs->end(),
+                [&sizes](const Type& a, const Type& b) {
+                    return sizes[&a] < sizes[&b];
+                }
+            );
+        }
+        return xs;
+    }
     
-    operator state(
-        void
-    ) const {
-        return this->s_;
+    /* Every subtree of %x, then %x without one of its subtrees,
+     * then %x with one of its subtrees shrunk, recursively. All
+     * of them have fewer nodes than %x.
+     */
+    std::list<Type>
+    shrinks(
+        const Type& x
+    ) {
+        std::list<Type> xs;
+        this->shrinks(x, [&xs](const Type& y) {
+            xs.push_back(y);
+            return true;
+        });
+        return xs;
+    }
+    
+    /* Give the values of %shrinks(x) to %visit one after the
+     * other, until it returns false. They are built in place in
+     * a single copy of %x, so %visit must copy the ones it
+     * keeps. Returns false if %visit stopped the walk.
+     */
+    bool
+    shrinks(
+        const Type& x,
+        const std::function<bool(const Type&)>& visit
+    ) {
+        Type y = x;
+        return shrinks_(y, y, visit);
     }
     
 private:
-    state s_;
+    static std::size_t
+    measure_(
+        const Type& x,
+        std::unordered_map<const Type*, std::size_t>& sizes
+    ) {
+        std::size_t n = 1;
+        auto cs = subtrees<Type>::of(x);
+        if (cs)
+            for (const auto& c : *cs)
+                n += measure_(c, sizes);
+        sizes[&x] = n;
+        return n;
+    }
+    
+    /* Walk the shrinks of %node, a subtree of %root, visiting
+     * %root with each of them in place of %node, and restoring
+     * %node after every visit.
+     */
+    static bool
+    shrinks_(
+        const Type& root,
+        Type& node,
+        const std::function<bool(const Type&)>& visit
+    ) {
+        auto cs = subtrees<Type>::of(node);
+        if (!cs)
+            return true;
+        
+        const auto n = cs->size();
+        for (std::size_t i = 0; i < n; ++i) {
+            Type saved = std::move(node);
+            auto& c = *std::next(subtrees<Type>::of(saved)->begin(), i);
+            node = std::move(c);
+            auto more = visit(root);
+            c = std::move(node);
+            node = std::move(saved);
+            if (!more)
+                return false;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            cs = subtrees<Type>::of(node);
+            auto j = std::next(cs->begin(), i);
+            Type saved = std::move(*j);
+            j = cs->erase(j);
+            auto more = visit(root);
+            cs->insert(j, std::move(saved));
+            if (!more)
+                return false;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            cs = subtrees<Type>::of(node);
+            if (!shrinks_(root, *std::next(cs->begin(), i), visit))
+                return false;
+        }
+        return true;
+    }
+    
 };
 
-struct qc_config
-{
-    qc_config(
+/* A sequence of commands run against a stateful system and a
+ * model of it, see %stateful_property.
+ */
+template
+<
+    typename Command
+>
+class commands :
+    public std::vector<Command>
+{
+public:
+    using std::vector<Command>::vector;
+};
+
+/* Settings for %commands_generator, sequences have at most
+ * %max_size commands. Raise it for soak tests.
+ */
+struct commands_config
+{
+    commands_config(
         void
     ) :
-        n_tests(0),
-        max_tests(128),
-        n_discards(0),
-        max_discards(1024)
+        max_size(100)
+    {}
+    
+    std::size_t max_size;
+};
+
+/* The settings used by the command sequence generators when
+ * none are given explicitly.
+ */
+inline commands_config&
+commands_settings(
+    void
+) {
+    static commands_config conf;
+    return conf;
+}
+
+/* Generate sequences of commands, each command with its own
+ * generator, see %arbitrary. Lengths are drawn like the sizes
+ * of byte buffers, see %bytes_generator.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class commands_generator :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    commands_generator(
+        Engine& engine,
+        const commands_config& conf = commands_settings()
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        conf_(conf)
     {}
     
+    virtual Type
+    operator()(
+        const std::size_t& n
+    ) {
+        auto gen = get_generator<
+            typename Type::value_type
+        >(this->engine());
+        
+        Type xs;
+        xs.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            xs.push_back(gen());
+        return xs;
+    }
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        return (*this)(draw_length_(this->engine(), this->conf_.max_size));
+    }
+    
+private:
+    commands_config conf_;
+};
+
+/* Shrink a sequence of commands. The list truncates it like
+ * %container_minimizer, %shrinks() removes chunks of commands,
+ * halving their size down to single commands and trying the
+ * last chunks first. To keep long sequences practical, it
+ * stops once it has copied 64 times the length of %x.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class commands_minimizer :
+    public minimizer<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    MINIMIZER_CTOR(commands_minimizer)
+    
+    virtual std::list<Type>
+    operator()(
+        const Type& x
+    ) {
+        auto min = get_minimizer<std::size_t>(this->engine());
+        
+        std::list<Type> xs;
+        for (auto n : min(x.size()))
+            xs.push_back(Type(x.begin(), x.begin() + n));
+        return xs;
+    }
+    
+    std::list<Type>
+    shrinks(
+        const Type& x
+    ) {
+        const auto n = x.size();
+        const auto budget = 64 * n;
+        std::size_t copied = 0;
+        
+        std::list<Type> xs;
+        for (auto chunk = std::max<std::size_t>(n / 2, 1); n; chunk /= 2) {
+            for (auto end = n; end > 0 && copied < budget; ) {
+                auto begin = end > chunk? end - chunk: 0;
+                Type y;
+                y.reserve(n - (end - begin));
+                y.insert(y.end(), x.begin(), x.begin() + begin);
+                y.insert(y.end(), x.begin() + end, x.end());
+                copied += y.size();
+                xs.push_back(std::move(y));
+                end = begin;
+            }
+            if (chunk == 1 || copied >= budget)
+                break;
+        }
+        return xs;
+    }
+    
+};
+
+template
+<
+    typename Command,
+    typename Engine
+>
+class arbitrary<
+    commands<Command>,
+    Engine
+> {
+public:
+    typedef commands_generator<
+        commands<Command>,
+        Engine
+    > generator_type;
+};
+
+template
+<
+    typename Command,
+    typename Engine
+>
+class shrink<
+    commands<Command>,
+    Engine
+> {
+public:
+    typedef commands_minimizer<
+        commands<Command>,
+        Engine
+    > minimizer_type;
+};
+
+/* A schedule of the deterministic scheduler, see
+ * %pct_scheduler: the threads by decreasing priority, and the
+ * steps at which the running thread is preempted. An empty
+ * schedule leaves the threads to the operating system.
+ */
+struct pct_schedule
+{
     bool
-    again(
+    empty(
         void
     ) const {
-        return (
-            n_tests < max_tests &&
-            n_discards < max_discards
+        return this->priorities.empty();
+    }
+    
+    std::vector<std::size_t> priorities;
+    std::vector<std::uint64_t> preemptions;
+};
+
+/* Sequences of commands run concurrently, one per thread,
+ * see %concurrent_property, with the schedule they are run
+ * with if %parallel_config::scheduled is set.
+ */
+template
+<
+    typename Command
+>
+class parallel_commands :
+    public std::vector<commands<Command>>
+{
+public:
+    using std::vector<commands<Command>>::vector;
+    
+    pct_schedule schedule;
+};
+
+/* Settings for %parallel_commands_generator and
+ * %concurrent_property: the number of threads, the maximum
+ * number of commands per thread, and how many times every
+ * history is run, since a single run rarely hits the
+ * interleaving which breaks it. Histories have at most 64
+ * commands in total, so %max_size is lowered to 64 /
+ * %n_threads when it exceeds it, and more than 64 threads are
+ * rejected.
+ *
+ * If %scheduled is set, the histories are run once each by
+ * %pct_scheduler instead, with a generated schedule of %depth
+ * - 1 preemptions within the first %n_steps steps.
+ */
+struct parallel_config
+{
+    parallel_config(
+        void
+    ) :
+        n_threads(2),
+        max_size(8),
+        n_runs(8),
+        scheduled(false),
+        depth(3),
+        n_steps(32)
+    {}
+    
+    std::size_t n_threads;
+    std::size_t max_size;
+    size_type n_runs;
+    bool scheduled;
+    std::size_t depth;
+    std::uint64_t n_steps;
+};
+
+/* The settings used by the concurrent properties when none are
+ * given explicitly.
+ */
+inline parallel_config&
+parallel_settings(
+    void
+) {
+    static parallel_config conf;
+    return conf;
+}
+
+/* Generate one sequence of commands per thread, see
+ * %commands_generator. Throws %std::invalid_argument for more
+ * than 64 threads.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class parallel_commands_generator :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    parallel_commands_generator(
+        Engine& engine,
+        const parallel_config& conf = parallel_settings()
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        conf_(conf)
+    {
+        if (this->conf_.n_threads > 64)
+            QCXX_THROW(std::invalid_argument,
+                "qcxx::parallel_commands_generator: more than 64 threads");
+        if (this->conf_.n_threads)
+            this->conf_.max_size = std::min<std::size_t>(
+                this->conf_.max_size, 64 / this->conf_.n_threads);
+    }
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        commands_config conf;
+        conf.max_size = this->conf_.max_size;
+        commands_generator<
+            typename Type::value_type,
+            Engine
+        > gen(this->engine(), conf);
+        
+        Type xs;
+        xs.reserve(this->conf_.n_threads);
+        for (std::size_t t = 0; t < this->conf_.n_threads; ++t)
+            xs.push_back(gen());
+        if (this->conf_.scheduled)
+            xs.schedule = this->schedule_();
+        return xs;
+    }
+    
+private:
+    parallel_config conf_;
+    
+    pct_schedule
+    schedule_(
+        void
+    ) {
+        pct_schedule s;
+        for (std::size_t t = 0; t < this->conf_.n_threads; ++t)
+            s.priorities.push_back(t);
+        std::shuffle(s.priorities.begin(), s.priorities.end(),
+            this->engine());
+        
+        std::uniform_int_distribution<std::uint64_t> step(
+            1, std::max<std::uint64_t>(this->conf_.n_steps, 1));
+        for (std::size_t d = 1; d < this->conf_.depth; ++d)
+            s.preemptions.push_back(step(this->engine()));
+        std::sort(s.preemptions.begin(), s.preemptions.end());
+        return s;
+    }
+};
+
+/* Shrink concurrent sequences of commands. The list truncates
+ * every thread by half at a time, %shrinks() empties one
+ * thread or removes one command, the last ones first, then
+ * simplifies the schedule by removing one preemption, moving
+ * one to an earlier step, or ordering the threads by index.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class parallel_commands_minimizer :
+    public minimizer<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    MINIMIZER_CTOR(parallel_commands_minimizer)
+    
+    virtual std::list<Type>
+    operator()(
+        const Type& x
+    ) {
+        std::list<Type> xs;
+        xs.push_back(x);
+        for (auto more = true; more; ) {
+            Type y = xs.back();
+            more = false;
+            for (auto& t : y) {
+                more = more || !t.empty();
+                t.resize(t.size() / 2);
+            }
+            if (more)
+                xs.push_back(std::move(y));
+        }
+        return xs;
+    }
+    
+    std::list<Type>
+    shrinks(
+        const Type& x
+    ) {
+        std::list<Type> xs;
+        for (std::size_t t = x.size(); t-- > 0; ) {
+            if (x[t].size() > 1) {
+                Type y = x;
+                y[t].clear();
+                xs.push_back(std::move(y));
+            }
+        }
+        for (std::size_t t = x.size(); t-- > 0; ) {
+            for (std::size_t i = x[t].size(); i-- > 0; ) {
+                Type y = x;
+                y[t].erase(y[t].begin() + i);
+                xs.push_back(std::move(y));
+            }
+        }
+        
+        const auto& preemptions = x.schedule.preemptions;
+        for (std::size_t i = preemptions.size(); i-- > 0; ) {
+            Type y = x;
+            y.schedule.preemptions.erase(
+                y.schedule.preemptions.begin() + i);
+            xs.push_back(std::move(y));
+        }
+        for (std::size_t i = preemptions.size(); i-- > 0; ) {
+            for (std::uint64_t step = 1; step < preemptions[i]; ++step) {
+                Type y = x;
+                y.schedule.preemptions[i] = step;
+                std::sort(y.schedule.preemptions.begin(),
+                    y.schedule.preemptions.end());
+                xs.push_back(std::move(y));
+            }
+        }
+        const auto& priorities = x.schedule.priorities;
+        if (!std::is_sorted(priorities.begin(), priorities.end())) {
+            Type y = x;
+            std::sort(y.schedule.priorities.begin(),
+                y.schedule.priorities.end());
+            xs.push_back(std::move(y));
+        }
+        return xs;
+    }
+    
+};
+
+template
+<
+    typename Command,
+    typename Engine
+>
+class arbitrary<
+    parallel_commands<Command>,
+    Engine
+> {
+public:
+    typedef parallel_commands_generator<
+        parallel_commands<Command>,
+        Engine
+    > generator_type;
+};
+
+template
+<
+    typename Command,
+    typename Engine
+>
+class shrink<
+    parallel_commands<Command>,
+    Engine
+> {
+public:
+    typedef parallel_commands_minimizer<
+        parallel_commands<Command>,
+        Engine
+    > minimizer_type;
+};
+
+/* Saturating multiplication and addition for the sizes of
+ * enumerations, which easily exceed %std::size_t.
+ */
+inline std::size_t
+enumeration_mul(
+    const std::size_t& a,
+    const std::size_t& b
+) {
+    return b && a > std::numeric_limits<std::size_t>::max() / b?
+        std::numeric_limits<std::size_t>::max():
+        a * b;
+}
+
+inline std::size_t
+enumeration_add(
+    const std::size_t& a,
+    const std::size_t& b
+) {
+    return a > std::numeric_limits<std::size_t>::max() - b?
+        std::numeric_limits<std::size_t>::max():
+        a + b;
+}
+
+/* Enumerate %Integral values by increasing magnitude, zero
+ * first, then -1, 1, -2, 2 and so on. Types of a single byte
+ * are enumerated completely, other types up to %depth.
+ */
+template
+<
+    typename Type
+>
+class integral_enumerator
+{
+public:
+    typedef Type value_type;
+    
+    explicit
+    integral_enumerator(
+        const size_type& depth
+    ) {
+        static_assert(std::is_integral<Type>::value,
+            "given Type is not Integral");
+        
+        if (sizeof(Type) == 1) {
+            this->n_ = std::size_t(1) << std::numeric_limits<
+                unsigned char
+            >::digits;
+        } else {
+            this->n_ = std::is_signed<Type>::value?
+                2 * std::size_t(depth) + 1:
+                std::size_t(depth) + 1;
+        }
+    }
+    
+    std::size_t
+    size(
+        void
+    ) const {
+        return this->n_;
+    }
+    
+    /* True if every value of the type is enumerated.
+     */
+    bool
+    complete(
+        void
+    ) const {
+        return sizeof(Type) == 1;
+    }
+    
+    Type
+    operator[](
+        const std::size_t& i
+    ) const {
+        if (!std::is_signed<Type>::value)
+            return static_cast<Type>(i);
+        
+        return static_cast<Type>(i % 2?
+            -static_cast<long long>((i + 1) / 2):
+            static_cast<long long>(i / 2));
+    }
+    
+private:
+    std::size_t n_;
+};
+
+/* Enumerate containers of up to %depth elements, shortest
+ * first, whose elements are enumerated to the same depth. The
+ * given container must have a %push_back() method.
+ */
+template
+<
+    typename Type
+>
+class container_enumerator
+{
+public:
+    typedef Type value_type;
+    typedef typename enumerable<
+        typename Type::value_type
+    >::enumerator_type element_enumerator_type;
+    
+    explicit
+    container_enumerator(
+        const size_type& depth
+    ) :
+        depth_(depth),
+        elements_(depth),
+        n_(0)
+    {
+        std::size_t m = 1;
+        for (size_type l = 0; l <= depth; ++l) {
+            this->n_ = enumeration_add(this->n_, m);
+            m = enumeration_mul(m, this->elements_.size());
+        }
+    }
+    
+    std::size_t
+    size(
+        void
+    ) const {
+        return this->n_;
+    }
+    
+    bool
+    complete(
+        void
+    ) const {
+        return false;
+    }
+    
+    Type
+    operator[](
+        std::size_t i
+    ) const {
+        const auto k = this->elements_.size();
+        
+        std::size_t m = 1;
+        size_type l = 0;
+        while (l < this->depth_ && i >= m) {
+            i -= m;
+            m = enumeration_mul(m, k);
+            ++l;
+        }
+        
+        Type xs;
+        for (size_type j = 0; j < l; ++j) {
+            xs.push_back(this->elements_[i % k]);
+            i /= k;
+        }
+        return xs;
+    }
+    
+private:
+    size_type depth_;
+    element_enumerator_type elements_;
+    std::size_t n_;
+};
+
+/* Enumerate the cartesian product of the values of all the
+ * given types, the last type varying the fastest.
+ */
+template
+<
+    typename... Types
+>
+class product_enumerator
+{
+public:
+    typedef std::tuple<
+        Types...
+    > value_type;
+    
+    explicit
+    product_enumerator(
+        const size_type& depth
+    ) :
+        enumerators_(get_enumerator<Types>(depth)...),
+        n_(1)
+    {
+        for (auto m : {get_enumerator<Types>(depth).size()...})
+            this->n_ = enumeration_mul(this->n_, m);
+    }
+    
+    std::size_t
+    size(
+        void
+    ) const {
+        return this->n_;
+    }
+    
+    bool
+    complete(
+        void
+    ) const {
+        return this->complete_(std::index_sequence_for<Types...>());
+    }
+    
+    value_type
+    operator[](
+        const std::size_t& i
+    ) const {
+        return this->at_(i, std::index_sequence_for<Types...>());
+    }
+    
+private:
+    template
+    <
+        std::size_t... I
+    >
+    bool
+    complete_(
+        std::index_sequence<I...>
+    ) const {
+        for (auto c : {std::get<I>(this->enumerators_).complete()...}) {
+            if (!c)
+                return false;
+        }
+        return true;
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    value_type
+    at_(
+        std::size_t i,
+        std::index_sequence<I...>
+    ) const {
+        std::size_t is[] = {
+            std::get<I>(this->enumerators_).size()...
+        };
+        for (auto j = sizeof...(Types); j-- > 0; ) {
+            auto k = is[j];
+            is[j] = i % k;
+            i /= k;
+        }
+        return value_type(
+            std::get<I>(this->enumerators_)[is[I]]...
+        );
+    }
+    
+    std::tuple<
+        typename enumerable<Types>::enumerator_type...
+    > enumerators_;
+    std::size_t n_;
+};
+
+/* Settings for showing values. Containers with more than
+ * %head + %tail elements are truncated to their first %head
+ * and last %tail elements followed by the total count. If
+ * %dump_prefix is non-empty the full value of a truncated
+ * container is written to a side file named after it.
+ */
+struct show_config
+{
+    show_config(
+        void
+    ) :
+        head(32),
+        tail(8),
+        dump_prefix()
+    {}
+    
+    std::size_t head;
+    std::size_t tail;
+    std::string dump_prefix;
+};
+
+/* The settings used by %show_container() when none are given
+ * explicitly.
+ */
+inline show_config&
+show_settings(
+    void
+) {
+    static show_config conf;
+    return conf;
+}
+
+/**
+ * %show_element_()
+ * @{
+ */
+template
+<
+    typename Type
+>
+void
+show_element_(
+    std::ostream& out,
+    const Type& x
+) {
+    out << x;
+}
+inline void
+show_element_(
+    std::ostream& out,
+    const signed char& x
+) {
+    out << static_cast<int>(x);
+}
+inline void
+show_element_(
+    std::ostream& out,
+    const unsigned char& x
+) {
+    out << static_cast<unsigned int>(x);
+}
+/**
+ * @}
+ */
+
+/**
+ * %show_range()
+ * @{
+ */
+template
+<
+    typename Iterator
+>
+void
+show_range(
+    std::ostream& out,
+    Iterator begin,
+    Iterator end,
+    bool first = true
+) {
+    for (; begin != end; ++begin) {
+        if (!first)
+            out << ", ";
+        show_element_(out, *begin);
+        first = false;
+    }
+}
+/**
+ * @}
+ */
+
+/* A new side file name for the full value of a truncated
+ * container, numbered across all container types.
+ */
+inline std::string
+dump_path_(
+    const std::string& prefix
+) {
+    static std::atomic<unsigned long> n_dumps(0);
+    
+    return prefix + "-" + std::to_string(++n_dumps) + ".txt";
+}
+
+/* Stream a container to %out without any intermediate copy,
+ * truncating it according to %conf.
+ */
+template
+<
+    typename Container
+>
+void
+show_container(
+    std::ostream& out,
+    const Container& xs,
+    const show_config& conf
+) {
+    auto n = static_cast<std::size_t>(xs.size());
+    
+    out << "[";
+    
+    if (n <= conf.head || n - conf.head <= conf.tail) {
+        show_range(out, xs.begin(), xs.end());
+        out << "]"
+            << '\n';
+        return;
+    }
+    
+    auto head = xs.begin();
+    std::advance(head, conf.head);
+    show_range(out, xs.begin(), head);
+    
+    out << (conf.head? ", ...": "...");
+    show_range(out, std::prev(xs.end(), conf.tail), xs.end(), false);
+    
+    out << "] ("
+        << n
+        << " elements";
+    
+    if (!conf.dump_prefix.empty()) {
+        auto path = dump_path_(conf.dump_prefix);
+        std::ofstream file(path);
+        
+        file << "[";
+        show_range(file, xs.begin(), xs.end());
+        file << "]"
+             << '\n';
+        
+        if (file)
+            out << ", full value in " << path;
+    }
+    
+    out << ")"
+        << '\n';
+}
+
+template
+<
+    typename Container
+>
+void
+show_container(
+    std::ostream& out,
+    const Container& xs
+) {
+    show_container(out, xs, show_settings());
+}
+
+template
+<
+    typename Type
+>
+void
+show(
+    std::ostream& out,
+    const Type& x
+) {
+    out << x
+        << '\n';
+}
+
+template
+<
+    std::size_t N
+>
+void
+show(
+    std::ostream& out,
+    const std::array<std::uint8_t, N>& xs
+) {
+    show_container(out, xs);
+}
+
+template
+<
+    typename Command
+>
+void
+show(
+    std::ostream& out,
+    const commands<Command>& xs
+) {
+    show_container(out, xs);
+}
+
+/* Show concurrent sequences of commands as one list, the
+ * threads separated by bars, followed by their schedule if
+ * any.
+ */
+template
+<
+    typename Command
+>
+void
+show(
+    std::ostream& out,
+    const parallel_commands<Command>& xs
+) {
+    out << "[";
+    for (std::size_t t = 0; t < xs.size(); ++t) {
+        if (t)
+            out << " | ";
+        show_range(out, xs[t].begin(), xs[t].end());
+    }
+    out << "]";
+    
+    const auto& s = xs.schedule;
+    if (!s.empty()) {
+        out << " priorities [";
+        show_range(out, s.priorities.begin(), s.priorities.end());
+        out << "] preemptions [";
+        show_range(out, s.preemptions.begin(), s.preemptions.end());
+        out << "]";
+    }
+    out << '\n';
+}
+
+/* Show a small integral value as a number rather than as a
+ * character.
+ */
+template
+<
+    typename Type
+>
+void
+show_numeric(
+    std::ostream& out,
+    const Type& x
+) {
+    out << +x
+        << '\n';
+}
+
+#define SHOWABLE_TYPE(_Type, _Show)                                         \
+    template                                                                \
+    <                                                                       \
+    >                                                                       \
+    inline void                                                             \
+    show<                                                                   \
+        _Type                                                               \
+    >(                                                                      \
+        std::ostream& out,                                                  \
+        const _Type& t                                                      \
+    ) {                                                                     \
+        _Show(out, t);                                                      \
+    }
+
+/**
+ * %show_all()
+ * @{
+ */
+template
+<
+    typename Type
+>
+void
+show_all(
+    std::ostream& out,
+    const Type& x
+) {
+    show(out, x);
+}
+template
+<
+    typename Type,
+    typename... Container
+>
+void
+show_all(
+    std::ostream& out,
+    const Type& x,
+    const Container&... xs
+) {
+    show_all(out, x);
+    show_all(out, xs...);
+}
+/**
+ * @}
+ */
+
+/* Thrown by generators which fail to produce a value, for
+ * example when a precondition can not be satisfied. The test
+ * case is then counted as discarded instead of failed.
+ */
+class discarded :
+    public std::runtime_error
+{
+public:
+    explicit
+    discarded(
+        const std::string& what
+    ) :
+        std::runtime_error(what)
+    {}
+};
+
+/**
+ * %sample_()
+ * @{
+ */
+template
+<
+    typename Generator
+>
+auto
+sample_(
+    Generator& gen,
+    int
+) -> decltype(gen.sample()) {
+    return gen.sample();
+}
+template
+<
+    typename Generator
+>
+std::list<typename Generator::value_type>
+sample_(
+    Generator& gen,
+    long
+) {
+    return get_minimizer<
+        typename Generator::value_type
+    >(gen.engine())(gen());
+}
+/**
+ * @}
+ */
+
+/**
+ * %sized_()
+ * @{
+ */
+template
+<
+    typename Generator
+>
+auto
+sized_(
+    Generator& gen,
+    const std::size_t& size,
+    int
+) -> decltype(gen(size)) {
+    return gen(size);
+}
+template
+<
+    typename Generator
+>
+typename Generator::value_type
+sized_(
+    Generator& gen,
+    const std::size_t&,
+    long
+) {
+    return gen();
+}
+/**
+ * @}
+ */
+
+/* Generate a value of the given size with the %arbitrary
+ * generator of %Type, if it takes a size like the container
+ * generators do, otherwise an arbitrary value.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+Type
+generate_sized(
+    Engine& engine,
+    const std::size_t& size
+) {
+    auto gen = get_generator<Type>(engine);
+    return sized_(gen, size, 0);
+}
+
+/* Generate a value together with its shrunk values, using the
+ * %sample() method of the generator if it has one, otherwise
+ * the minimizer of the generated type. The generated value is
+ * always the first element.
+ */
+template
+<
+    typename Generator
+>
+std::list<typename std::decay<Generator>::type::value_type>
+sample(
+    Generator&& gen
+) {
+    return sample_(gen, 0);
+}
+
+enum state {
+    TEST_FAILURE = 0,
+    TEST_SUCCESS = 1,
+    TEST_DISCARD = 2,
+    TEST_NOTHING = 3
+};
+
+class result
+{
+public:
+    result(
+        void
+    ) :
+        s_(TEST_NOTHING),
+        where_(nullptr)
+    {}
+    
+    result(
+        const bool& s
+    ) :
+        s_(static_cast<state>(s)),
+        where_(nullptr)
+    {}
+    
+    result(
+        const state& s,
+        const char* where = nullptr
+    ) :
+        s_(s),
+        where_(where)
+    {}
+    
+    operator state(
+        void
+    ) const {
+        return this->s_;
+    }
+    
+    /* Where the result was decided, if known. Used to break
+     * down discards by their cause, see %DISCARD_IF. Must be a
+     * string literal, as results outlive the tests.
+     */
+    const char*
+    where(
+        void
+    ) const {
+        return this->where_;
+    }
+    
+private:
+    state s_;
+    const char* where_;
+};
+
+/* Discard the current test case if %_Condition holds, recording
+ * the condition as the cause of the discard.
+ */
+#define DISCARD_IF(_Condition)                                              \
+    do {                                                                    \
+        if (_Condition)                                                     \
+            return qcxx::result(qcxx::TEST_DISCARD, #_Condition);           \
+    } while (0)
+
+/* When to test every value of the parameters instead of
+ * random ones, see %enumerable.
+ */
+enum enumeration {
+    ENUMERATE_NEVER = 0,
+    ENUMERATE_AUTO = 1,
+    ENUMERATE_ALWAYS = 2
+};
+
+struct qc_config
+{
+    qc_config(
+        void
+    ) :
+        n_tests(0),
+        max_tests(128),
+        n_discards(0),
+        max_discards(1024),
+        n_rejects(0),
+        max_retries(64),
+        max_shrinks(1024),
+        batch_size(1024),
+        count_events(false),
+        count_allocs(false),
+        timeout(0),
+        isolate(false),
+        n_workers(0),
+        soak(false),
+        soak_for(0),
+        progress_every(std::chrono::seconds(60)),
+        checkpoint(),
+        seed(0),
+        fixed_seed(false),
+        enumerate(ENUMERATE_AUTO),
+        max_enumerated(65536),
+        depth(4),
+        n_threads(0)
+    {}
+    
+    bool
+    again(
+        void
+    ) const {
+        if (soak) {
+            const auto t = std::max<size_type>(max_tests, 1);
+            const auto d = std::max<size_type>(max_discards, 1);
+            return n_discards * t < (n_tests + t) * d;
+        }
+        return (
+            n_tests < max_tests &&
+            n_discards < max_discards
+        );
+    }
+    
+    size_type n_tests;
+    size_type max_tests;
+    size_type n_discards;
+    size_type max_discards;
+    
+    /* Generated values rejected by the precondition of the
+     * property, and how many times generation is retried for
+     * a single test case before it is discarded.
+     */
+    size_type n_rejects;
+    size_type max_retries;
+    
+    /* How many times a counterexample is tested again while it
+     * is shrunk further using the %shrinks() method of the
+     * minimizers which have one, see %subtree_minimizer.
+     */
+    size_type max_shrinks;
+    
+    /* The number of values tested at a time by a batch
+     * property, see %batch_property.
+     */
+    size_type batch_size;
+    
+    /* Count hardware events around every test, or batch, see
+     * %perf_counters. Properties with %EXPECT_COUNTERS always
+     * count them.
+     */
+    bool count_events;
+    
+    /* Report the allocations of every passed test, see
+     * %alloc_scope. The allocation tracker must be installed.
+     */
+    bool count_allocs;
+    
+    /* A test taking longer than %timeout fails, and is shrunk
+     * toward the smallest values which still take longer, zero
+     * meaning no limit. A test still running after ten times
+     * %timeout is taken to hang: the watchdog reports the run as
+     * failed, with the values and the seed, and terminates the
+     * process, unless the run is isolated, in which case the
+     * child is killed. See %property::timed_out().
+     */
+    std::chrono::nanoseconds timeout;
+    
+    /* Run the tests in a child process forked from the property
+     * once it has been set up, so that crashes, signals and
+     * hangs fail the run instead of killing it. The child runs
+     * every test until one fails or crashes, then the failing
+     * values are generated again and shrunk with one fresh
+     * child per test, so %test() must not draw from the engine.
+     * Hardware counters, allocations and latencies are not
+     * reported, and batch properties are not isolated. Ignored
+     * where %fork() is not available.
+     */
+    bool isolate;
+    
+    /* Split the tests among %n_workers child processes when
+     * greater than one, for properties which cannot be tested by
+     * several threads of one process. Every worker runs its
+     * share of %max_tests and %max_discards with an engine seeded
+     * by %worker_seed(), so that a run is reproduced by its seed
+     * and number of workers. Their counts and classes are
+     * merged. Once one fails, the others are stopped and its
+     * failing values are shrunk as in an isolated run. Batch
+     * properties are not split. Ignored where %fork() is not
+     * available.
+     */
+    size_type n_workers;
+    
+    /* Keep testing until a test fails instead of stopping after
+     * %max_tests, for at most %soak_for in total, zero meaning
+     * forever. A soak run still gives up when it has discarded
+     * more than %max_discards tests per %max_tests passed. The
+     * progress of isolated and sharded soak runs counts the
+     * tests and discards of their children, but not classes.
+     */
+    bool soak;
+    std::chrono::nanoseconds soak_for;
+    
+    /* How often soak runs and runs with a %checkpoint hand their
+     * progress to %reporter::progress().
+     */
+    std::chrono::nanoseconds progress_every;
+    
+    /* The file progress is saved to along with every progress
+     * report, empty meaning none: the seed, the counts of
+     * tests, discards, classes and discard sites, the elapsed
+     * time and the state of the engine. A run with a checkpoint
+     * resumes from it when the file exists, generating the
+     * values the interrupted run would have generated next, and
+     * removes it when done. Batch properties are checkpointed
+     * between batches, isolated runs are not checkpointed.
+     */
+    std::string checkpoint;
+    
+    /* The number of discards per cause.
+     */
+    std::map<std::string, size_type> discard_sites;
+    
+    /* The number of passed tests per class, and the minimum
+     * percentage of passed tests required for some classes, see
+     * %property::label() and %property::cover().
+     */
+    std::map<std::string, size_type> labels;
+    std::map<std::string, double> coverage;
+    
+    /* The seed used for the engine. When %fixed_seed is false
+     * %quickCheckWith() draws a new seed from the device and
+     * stores it here so that the run can be reproduced.
+     */
+    seed_type seed;
+    bool fixed_seed;
+    
+    /* With %ENUMERATE_AUTO a property whose parameters are all
+     * %enumerable is tested exhaustively if every one of their
+     * values can be enumerated and there are at most
+     * %max_enumerated of them, as for single-byte types and
+     * pairs of them. With %ENUMERATE_ALWAYS it is tested with
+     * every value up to %depth, regardless of their number, and
+     * %quickCheckWith() throws %std::logic_error if they are not
+     * all %enumerable.
+     * Exhaustive runs are spread over %n_threads threads, zero
+     * meaning one per core.
+     */
+    enumeration enumerate;
+    size_type max_enumerated;
+    size_type depth;
+    size_type n_threads;
+    
+};
+
+/* The settings used by %quickCheck(), which %configure() sets
+ * from the command line. %quickCheckWith() uses the settings
+ * it is given as they are: start them from a copy of these,
+ * or pass them to %configure(), for the command line to apply.
+ */
+inline qc_config&
+qc_settings(
+    void
+) {
+    static qc_config conf;
+    return conf;
+}
+
+/* Set %conf from the options of the command line which start
+ * with "--qcxx-", removing them from %argv and %argc so that
+ * only the others are left to the program:
+ *
+ *     --qcxx-seed=N          the seed, which is then fixed
+ *     --qcxx-max-tests=N     %qc_config::max_tests
+ *     --qcxx-workers=N       %qc_config::n_workers
+ *     --qcxx-isolate         %qc_config::isolate
+ *     --qcxx-timeout-ms=N    %qc_config::timeout
+ *
+ * By default only %quickCheck() sees these options, see
+ * %qc_settings(). Throws %std::invalid_argument on unknown or
+ * malformed options.
+ */
+inline void
+configure(
+    int& argc,
+    char* argv[],
+    qc_config& conf = qc_settings()
+) {
+    static const std::string prefix = "--qcxx-";
+    
+    int n = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix)) {
+            argv[n++] = argv[i];
+            continue;
+        }
+        
+        const auto equals = arg.find('=');
+        const auto name = arg.substr(prefix.size(), equals - prefix.size());
+        const auto value = equals == std::string::npos?
+            std::string(): arg.substr(equals + 1);
+        auto number = [&](void) {
+            char* end = nullptr;
+            errno = 0;
+            auto n = std::strtoull(value.c_str(), &end, 10);
+            if (value.empty() || !std::isdigit(
+                    static_cast<unsigned char>(value[0])) ||
+                    *end || errno) {
+                QCXX_THROW(std::invalid_argument,
+                    "qcxx::configure: malformed option");
+            }
+            return static_cast<std::uint64_t>(n);
+        };
+        
+        if (name == "seed") {
+            conf.seed = number();
+            conf.fixed_seed = true;
+        } else if (name == "max-tests") {
+            conf.max_tests = number();
+        } else if (name == "workers") {
+            conf.n_workers = number();
+        } else if (name == "timeout-ms") {
+            conf.timeout = std::chrono::milliseconds(number());
+        } else if (name == "isolate" && equals == std::string::npos) {
+            conf.isolate = true;
+        } else {
+            QCXX_THROW(std::invalid_argument,
+                "qcxx::configure: unknown option");
+        }
+    }
+    if (n < argc) {
+        argc = n;
+        argv[n] = nullptr;
+    }
+}
+
+/* The name of a final %state, as used by the reporters.
+ */
+inline const char*
+state_name(
+    const state& s
+) {
+    switch (s) {
+    case TEST_FAILURE:
+        return "failure";
+    case TEST_SUCCESS:
+        return "success";
+    case TEST_DISCARD:
+        return "gave-up";
+    default:
+        return "nothing";
+    }
+}
+
+/* A histogram of durations, or other non-negative integers,
+ * in buckets of eight per power of two, so that quantiles are
+ * within an eighth of the recorded values. The count, sum and
+ * limits are exact.
+ */
+class histogram
+{
+public:
+    histogram(
+        void
+    ) :
+        counts_(),
+        n_(0),
+        sum_(0),
+        min_(std::numeric_limits<std::uint64_t>::max()),
+        max_(0)
+    {}
+    
+    void
+    add(
+        const std::uint64_t& x
+    ) {
+        this->counts_[bucket_(x)]++;
+        this->n_++;
+        this->sum_ += x;
+        this->min_ = std::min(this->min_, x);
+        this->max_ = std::max(this->max_, x);
+    }
+    
+    void
+    merge(
+        const histogram& h
+    ) {
+        for (std::size_t i = 0; i < this->counts_.size(); ++i)
+            this->counts_[i] += h.counts_[i];
+        this->n_ += h.n_;
+        this->sum_ += h.sum_;
+        this->min_ = std::min(this->min_, h.min_);
+        this->max_ = std::max(this->max_, h.max_);
+    }
+    
+    std::uint64_t
+    count(
+        void
+    ) const {
+        return this->n_;
+    }
+    
+    std::uint64_t
+    sum(
+        void
+    ) const {
+        return this->sum_;
+    }
+    
+    double
+    mean(
+        void
+    ) const {
+        return this->n_? static_cast<double>(this->sum_) / this->n_: 0.0;
+    }
+    
+    std::uint64_t
+    max(
+        void
+    ) const {
+        return this->max_;
+    }
+    
+    /* The smallest recorded value which is not exceeded by a
+     * fraction %q of the values, rounded down to its bucket.
+     */
+    std::uint64_t
+    quantile(
+        const double& q
+    ) const {
+        if (!this->n_)
+            return 0;
+        
+        auto k = static_cast<std::uint64_t>(std::ceil(q * this->n_));
+        k = std::max<std::uint64_t>(k, 1);
+        
+        std::uint64_t n = 0;
+        for (std::size_t i = 0; i < this->counts_.size(); ++i) {
+            n += this->counts_[i];
+            if (n >= k)
+                return std::min(std::max(lower_(i), this->min_), this->max_);
+        }
+        return this->max_;
+    }
+    
+private:
+    std::array<std::uint64_t, 496> counts_;
+    std::uint64_t n_;
+    std::uint64_t sum_;
+    std::uint64_t min_;
+    std::uint64_t max_;
+    
+    static std::size_t
+    bucket_(
+        const std::uint64_t& x
+    ) {
+        if (x < 8)
+            return static_cast<std::size_t>(x);
+        unsigned int e = 3;
+        while (x >> (e + 1))
+            ++e;
+        return (e - 2) * 8 + ((x >> (e - 3)) & 7);
+    }
+    
+    static std::uint64_t
+    lower_(
+        const std::size_t& i
+    ) {
+        if (i < 8)
+            return i;
+        return (8 + i % 8) << (i / 8 - 1);
+    }
+};
+
+/* The outcome of running a single property, handed to a
+ * %reporter once the property is done.
+ */
+struct report
+{
+    report(
+        void
+    ) :
+        status(TEST_NOTHING),
+        n_tests(0),
+        n_discards(0),
+        n_rejects(0),
+        seed(0),
+        elapsed(0),
+        exhaustive(false)
+    {}
+    
+    std::string name;
+    state status;
+    size_type n_tests;
+    size_type n_discards;
+    size_type n_rejects;
+    seed_type seed;
+    std::chrono::nanoseconds elapsed;
+    
+    /* True if every value of the parameters was tested, see
+     * %enumerable.
+     */
+    bool exhaustive;
+    
+    /* One shown value per parameter of the (shrunk)
+     * counterexample, empty unless the property failed.
+     */
+    std::vector<std::string> counterexample;
+    
+    /* The number of discards per cause, most frequent first.
+     */
+    std::vector<std::pair<std::string, size_type>> discard_sites;
+    
+    /* The number of passed tests per class, most frequent first,
+     * the required percentages and the classes which did not
+     * reach them.
+     */
+    std::vector<std::pair<std::string, size_type>> labels;
+    std::map<std::string, double> coverage;
+    std::vector<std::string> uncovered;
+    
+    /* Measurements added by the property, in order, see
+     * %property::summarize().
+     */
+    std::vector<std::pair<std::string, double>> metrics;
+    
+    /* Additional information, like the message of a caught
+     * exception.
+     */
+    std::string message;
+};
+
+/* Base class for reporters. A reporter is given one %report
+ * per property and decides how, and when, it is written.
+ */
+class reporter
+{
+public:
+    virtual
+    ~reporter(
+        void
+    ) {
+    }
+    
+    virtual void
+    operator()(
+        const report& rep
+    ) = 0;
+    
+    /* Called periodically during soak runs and runs with a
+     * checkpoint, see %qc_config::soak, with a report of the
+     * run so far: its status is %TEST_NOTHING and its metrics
+     * are the rates of tests and discards since the previous
+     * one.
+     */
+    virtual void
+    progress(
+        const report&
+    ) {
+    }
+    
+    virtual void
+    flush(
+        void
+    ) {
+    }
+};
+
+/* A reporter which discards every report.
+ */
+class null_reporter :
+    public reporter
+{
+public:
+    virtual void
+    operator()(
+        const report&
+    ) {
+    }
+};
+
+/* Base class for reporters writing to a %std::ostream. Each
+ * record is formatted in full before it is handed to %emit(),
+ * which writes it with a single call. Records are kept in a
+ * buffer until %capacity bytes have been collected; with the
+ * default capacity of zero every record is written at once.
+ * The stream is never flushed implicitly, only by %flush().
+ */
+class stream_reporter :
+    public reporter
+{
+public:
+    explicit
+    stream_reporter(
+        std::ostream& out,
+        const std::string::size_type& capacity = 0
+    ) :
+        out_(out),
+        capacity_(capacity)
+    {}
+    
+    virtual
+    ~stream_reporter(
+        void
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->drain();
+    }
+    
+    virtual void
+    flush(
+        void
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->drain();
+        this->out_.flush();
+    }
+    
+    std::ostream&
+    stream(
+        void
+    ) {
+        return this->out_;
+    }
+    
+protected:
+    void
+    emit(
+        const std::string& record
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->buffer_ += record;
+        if (this->buffer_.size() >= this->capacity_)
+            this->drain();
+    }
+    
+private:
+    void
+    drain(
+        void
+    ) {
+        if (!this->buffer_.empty()) {
+            this->out_.write(
+                this->buffer_.data(),
+                this->buffer_.size()
+            );
+            this->buffer_.clear();
+        }
+    }
+    
+    std::ostream& out_;
+    std::string::size_type capacity_;
+    std::string buffer_;
+    std::mutex mutex_;
+};
+
+/* Write reports in a human readable format.
+ */
+class text_reporter :
+    public stream_reporter
+{
+public:
+    explicit
+    text_reporter(
+        std::ostream& out,
+        const std::string::size_type& capacity = 0
+    ) :
+        stream_reporter(out, capacity)
+    {}
+    
+    virtual void
+    operator()(
+        const report& rep
+    ) {
+        std::ostringstream osstr;
+        
+        osstr << rep.name
+              << ": ";
+        
+        switch (rep.status) {
+        case TEST_SUCCESS:
+            osstr << "OK, "
+                  << rep.n_tests
+                  << (rep.exhaustive? " tests passed exhaustively, ":
+                        " tests passed, ")
+                  << rep.n_discards
+                  << " tests discarded";
+            sites(osstr, rep);
+            break;
+        case TEST_DISCARD:
+            osstr << "Gave up, after "
+                  << rep.n_tests
+                  << " tests and "
+                  << rep.n_discards
+                  << " discarded tests";
+            sites(osstr, rep);
+            break;
+        case TEST_FAILURE:
+            if (!rep.uncovered.empty()) {
+                osstr << "Insufficient coverage, after "
+                      << rep.n_tests
+                      << " tests";
+            } else if (!rep.message.empty()) {
+                osstr << "Failed, "
+                      << rep.message
+                      << ", after "
+                      << rep.n_tests + 1
+                      << " tests";
+            } else {
+                osstr << "Falsifiable, after "
+                      << rep.n_tests + 1
+                      << " tests";
+            }
+            osstr << " (seed "
+                  << rep.seed
+                  << ")";
+            break;
+        default:
+            osstr << "Nothing tested";
+            break;
+        }
+        
+        osstr << '\n';
+        for (const auto& x : rep.counterexample)
+            osstr << x << '\n';
+        labels(osstr, rep);
+        metrics(osstr, rep);
+        
+        this->emit(osstr.str());
+    }
+    
+    virtual void
+    progress(
+        const report& rep
+    ) {
+        std::ostringstream osstr;
+        
+        osstr << rep.name
+              << ": running, "
+              << rep.n_tests
+              << " tests passed, "
+              << rep.n_discards
+              << " tests discarded";
+        sites(osstr, rep);
+        osstr << " (seed "
+              << rep.seed
+              << ")"
+              << '\n';
+        labels(osstr, rep);
+        metrics(osstr, rep);
+        
+        this->emit(osstr.str());
+    }
+    
+private:
+    static void
+    labels(
+        std::ostream& out,
+        const report& rep
+    ) {
+        auto percent = [&](const size_type& n) {
+            return rep.n_tests? 100.0 * n / rep.n_tests: 0.0;
+        };
+        auto line = [&](const std::string& label, const size_type& n) {
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%6.2f%% ", percent(n));
+            out << buffer
+                << label;
+            auto i = rep.coverage.find(label);
+            if (i != rep.coverage.end()) {
+                out << " (required "
+                    << i->second
+                    << "%)";
+            }
+            out << '\n';
+        };
+        
+        for (const auto& label : rep.labels)
+            line(label.first, label.second);
+        for (const auto& label : rep.uncovered) {
+            if (std::none_of(rep.labels.begin(), rep.labels.end(),
+                    [&](const auto& x) { return x.first == label; }))
+                line(label, 0);
+        }
+    }
+    
+    static void
+    metrics(
+        std::ostream& out,
+        const report& rep
+    ) {
+        for (const auto& m : rep.metrics) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.6g", m.second);
+            out << m.first
+                << ": "
+                << buffer
+                << '\n';
+        }
+    }
+    
+    static void
+    sites(
+        std::ostream& out,
+        const report& rep
+    ) {
+        if (rep.n_rejects) {
+            out << ", "
+                << rep.n_rejects
+                << " values rejected";
+        }
+        if (!rep.discard_sites.empty()) {
+            out << " (";
+            for (auto i = rep.discard_sites.begin();
+                    i != rep.discard_sites.end(); ++i) {
+                if (i != rep.discard_sites.begin())
+                    out << ", ";
+                out << i->first
+                    << ": "
+                    << i->second;
+            }
+            out << ")";
+        }
+    }
+};
+
+/* Write reports as JSON Lines, one object per report.
+ */
+class jsonl_reporter :
+    public stream_reporter
+{
+public:
+    explicit
+    jsonl_reporter(
+        std::ostream& out,
+        const std::string::size_type& capacity = 0
+    ) :
+        stream_reporter(out, capacity)
+    {}
+    
+    virtual void
+    operator()(
+        const report& rep
+    ) {
+        this->emit(this->record(rep, state_name(rep.status)));
+    }
+    
+    /* Progress reports have the status "running".
+     */
+    virtual void
+    progress(
+        const report& rep
+    ) {
+        this->emit(this->record(rep, "running"));
+    }
+    
+    /* Format %rep as one line, with the given %status.
+     */
+    static std::string
+    record(
+        const report& rep,
+        const char* status
+    ) {
+        std::string record;
+        
+        record += "{\"property\":";
+        quote(record, rep.name);
+        record += ",\"status\":\"";
+        record += status;
+        record += "\",\"tests\":";
+        record += std::to_string(rep.n_tests);
+        record += ",\"discards\":";
+        record += std::to_string(rep.n_discards);
+        record += ",\"rejects\":";
+        record += std::to_string(rep.n_rejects);
+        record += ",\"discard_sites\":{";
+        for (auto i = rep.discard_sites.begin();
+                i != rep.discard_sites.end(); ++i) {
+            if (i != rep.discard_sites.begin())
+                record += ',';
+            quote(record, i->first);
+            record += ':';
+            record += std::to_string(i->second);
+        }
+        record += '}';
+        record += ",\"seed\":";
+        record += std::to_string(rep.seed);
+        record += ",\"elapsed_ns\":";
+        record += std::to_string(rep.elapsed.count());
+        record += ",\"exhaustive\":";
+        record += rep.exhaustive? "true": "false";
+        record += ",\"counterexample\":[";
+        for (auto i = rep.counterexample.begin();
+                i != rep.counterexample.end(); ++i) {
+            if (i != rep.counterexample.begin())
+                record += ',';
+            quote(record, *i);
+        }
+        record += "],\"labels\":{";
+        for (auto i = rep.labels.begin(); i != rep.labels.end(); ++i) {
+            if (i != rep.labels.begin())
+                record += ',';
+            quote(record, i->first);
+            record += ':';
+            record += std::to_string(i->second);
+        }
+        record += "},\"coverage\":{";
+        for (auto i = rep.coverage.begin(); i != rep.coverage.end(); ++i) {
+            if (i != rep.coverage.begin())
+                record += ',';
+            quote(record, i->first);
+            record += ':';
+            record += std::to_string(i->second);
+        }
+        record += "},\"uncovered\":[";
+        for (auto i = rep.uncovered.begin(); i != rep.uncovered.end(); ++i) {
+            if (i != rep.uncovered.begin())
+                record += ',';
+            quote(record, *i);
+        }
+        record += "],\"metrics\":{";
+        for (auto i = rep.metrics.begin(); i != rep.metrics.end(); ++i) {
+            if (i != rep.metrics.begin())
+                record += ',';
+            quote(record, i->first);
+            record += ':';
+            record += std::isfinite(i->second)?
+                std::to_string(i->second): "null";
+        }
+        record += "},\"message\":";
+        quote(record, rep.message);
+        record += "}\n";
+        
+        return record;
+    }
+    
+    /* Append %s to %out as a quoted JSON string. Bytes which
+     * are not part of valid UTF-8 are escaped as the code point
+     * of the same value.
+     */
+    static void
+    quote(
+        std::string& out,
+        const std::string& s
+    ) {
+        out += '"';
+        for (std::size_t i = 0; i < s.size(); ) {
+            auto c = s[i];
+            auto m = code_point_(s, i);
+            if (m > 1) {
+                out.append(s, i, m);
+                i += m;
+                continue;
+            }
+            ++i;
+            
+            switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20 || !m) {
+                    char esc[8];
+                    std::snprintf(esc, sizeof(esc), "\\u%04x",
+                        static_cast<unsigned int>(
+                            static_cast<unsigned char>(c)));
+                    out += esc;
+                } else
+                    out += c;
+                break;
+            }
+        }
+        out += '"';
+    }
+    
+private:
+    /* The length of the valid UTF-8 code point starting at
+     * %s[i], or zero if there is none.
+     */
+    static std::size_t
+    code_point_(
+        const std::string& s,
+        const std::size_t& i
+    ) {
+        auto at = [&](const std::size_t& k) -> unsigned char {
+            return i + k < s.size()? s[i + k]: 0;
+        };
+        
+        auto b = at(0);
+        std::size_t m = b < 0x80? 1: b < 0xc2? 0: b < 0xe0? 2:
+            b < 0xf0? 3: b < 0xf5? 4: 0;
+        unsigned char lo = b == 0xe0? 0xa0: b == 0xf0? 0x90: 0x80;
+        unsigned char hi = b == 0xed? 0x9f: b == 0xf4? 0x8f: 0xbf;
+        if (m > 1 && (at(1) < lo || at(1) > hi))
+            return 0;
+        for (std::size_t k = 2; k < m; ++k) {
+            if ((at(k) & 0xc0) != 0x80)
+                return 0;
+        }
+        return m;
+    }
+};
+
+/* Get the value shown by %show() as a string, without the
+ * trailing newline.
+ */
+template
+<
+    typename Type
+>
+std::string
+show_string(
+    const Type& x
+) {
+    std::ostringstream osstr;
+    show(osstr, x);
+    auto s = osstr.str();
+    if (!s.empty() && s.back() == '\n')
+        s.pop_back();
+    return s;
+}
+
+/* Complexity classes, in increasing order, see
+ * %checkComplexityWith().
+ */
+enum complexity {
+    COMPLEXITY_1 = 0,
+    COMPLEXITY_LOG_N = 1,
+    COMPLEXITY_N = 2,
+    COMPLEXITY_N_LOG_N = 3,
+    COMPLEXITY_N2 = 4,
+    COMPLEXITY_N3 = 5,
+    COMPLEXITY_ANY = 6
+};
+
+inline const char*
+complexity_name(
+    const complexity& c
+) {
+    switch (c) {
+    case COMPLEXITY_1:
+        return "1";
+    case COMPLEXITY_LOG_N:
+        return "log n";
+    case COMPLEXITY_N:
+        return "n";
+    case COMPLEXITY_N_LOG_N:
+        return "n log n";
+    case COMPLEXITY_N2:
+        return "n^2";
+    case COMPLEXITY_N3:
+        return "n^3";
+    default:
+        return "any";
+    }
+}
+
+/* The complexity class written as %s, like "n log n" or
+ * "n^2", ignoring white space, see %EXPECT_COMPLEXITY.
+ */
+inline complexity
+complexity_of(
+    const std::string& s
+) {
+    std::string t;
+    for (auto c : s)
+        if (!std::isspace(static_cast<unsigned char>(c)))
+            t += c;
+    
+    for (int c = COMPLEXITY_1; c < COMPLEXITY_ANY; ++c) {
+        std::string u;
+        for (auto d : std::string(complexity_name(static_cast<complexity>(c))))
+            if (d != ' ')
+                u += d;
+        if (t == u)
+            return static_cast<complexity>(c);
+    }
+    if (t == "n*n" || t == "n2")
+        return COMPLEXITY_N2;
+    if (t == "n*n*n" || t == "n3")
+        return COMPLEXITY_N3;
+    
+    QCXX_THROW(std::invalid_argument, "qcxx::complexity_of: unknown class");
+}
+
+/* The value of the function of the complexity class %c at
+ * %n.
+ */
+inline double
+complexity_value(
+    const complexity& c,
+    const double& n
+) {
+    switch (c) {
+    case COMPLEXITY_1:
+        return 1;
+    case COMPLEXITY_LOG_N:
+        return std::log2(n);
+    case COMPLEXITY_N:
+        return n;
+    case COMPLEXITY_N_LOG_N:
+        return n * std::log2(n);
+    case COMPLEXITY_N2:
+        return n * n;
+    case COMPLEXITY_N3:
+        return n * n * n;
+    default:
+        return 0;
+    }
+}
+
+/* Hardware events counted by %perf_counters.
+ */
+enum counter {
+    COUNTER_CYCLES = 0,
+    COUNTER_INSTRUCTIONS = 1,
+    COUNTER_CACHE_MISSES = 2,
+    COUNTER_BRANCH_MISSES = 3,
+    N_COUNTERS = 4
+};
+
+inline const char*
+counter_name(
+    const counter& c
+) {
+    switch (c) {
+    case COUNTER_CYCLES:
+        return "cycles";
+    case COUNTER_INSTRUCTIONS:
+        return "instructions";
+    case COUNTER_CACHE_MISSES:
+        return "cache_misses";
+    case COUNTER_BRANCH_MISSES:
+        return "branch_misses";
+    default:
+        return "unknown";
+    }
+}
+
+/* Hardware performance counters of the calling thread, in
+ * user space, using perf_event_open(2) on Linux. Counters
+ * which can not be opened, because of the platform, the
+ * kernel, perf_event_paranoid or a container, are simply not
+ * %available(), and read as zero. Define
+ * QCXX_SKIP_PERF_COUNTERS to never use them.
+ */
+class perf_counters
+{
+public:
+    perf_counters(
+        void
+    ) :
+        fds_(),
+        values_()
+    {
+        this->fds_.fill(-1);
+    }
+    
+    perf_counters(
+        const perf_counters&
+    ) = delete;
+    
+    perf_counters&
+    operator=(
+        const perf_counters&
+    ) = delete;
+    
+    ~perf_counters(
+        void
+    ) {
+        this->close();
+    }
+    
+    /* Open every counter, returns true if any is available.
+     */
+    bool
+    open(
+        void
+    ) {
+        this->close();
+#ifdef QCXX_HAVE_PERF_COUNTERS
+        static const std::uint64_t events[N_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for (int i = 0; i < N_COUNTERS; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = events[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            this->fds_[i] = static_cast<int>(
+                ::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+        return this->available();
+    }
+    
+    void
+    close(
+        void
+    ) {
+        for (auto& fd : this->fds_) {
+#ifdef QCXX_HAVE_PERF_COUNTERS
+            if (fd >= 0)
+                ::close(fd);
+#endif
+            fd = -1;
+        }
+    }
+    
+    bool
+    available(
+        void
+    ) const {
+        return std::any_of(this->fds_.begin(), this->fds_.end(),
+            [](const int& fd) { return fd >= 0; });
+    }
+    
+    bool
+    available(
+        const counter& c
+    ) const {
+        return this->fds_[c] >= 0;
+    }
+    
+    void
+    start(
+        void
+    ) {
+#ifdef QCXX_HAVE_PERF_COUNTERS
+        for (auto fd : this->fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+    
+    void
+    stop(
+        void
+    ) {
+#ifdef QCXX_HAVE_PERF_COUNTERS
+        for (auto fd : this->fds_)
+            if (fd >= 0)
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (int i = 0; i < N_COUNTERS; ++i) {
+            std::uint64_t v = 0;
+            if (this->fds_[i] < 0 ||
+                    ::read(this->fds_[i], &v, sizeof(v)) != sizeof(v))
+                v = 0;
+            this->values_[i] = v;
+        }
+#endif
+    }
+    
+    /* The count of %c between the last %start() and %stop().
+     */
+    std::uint64_t
+    value(
+        const counter& c
+    ) const {
+        return this->values_[c];
+    }
+    
+private:
+    std::array<int, N_COUNTERS> fds_;
+    std::array<std::uint64_t, N_COUNTERS> values_;
+};
+
+/* Allocations made by a thread while they are tracked, see
+ * %alloc_scope. %peak is the largest number of bytes
+ * allocated and not yet freed at any time.
+ */
+struct alloc_stats
+{
+    std::size_t count;
+    std::size_t bytes;
+    std::size_t peak;
+};
+
+class alloc_scope;
+
+/* The allocation state of the calling thread, updated by the
+ * replaced global operator new and delete.
+ */
+struct alloc_state_
+{
+    bool tracking;
+    const alloc_scope* scope;
+    std::size_t count;
+    std::size_t bytes;
+    std::ptrdiff_t live;
+    std::ptrdiff_t peak;
+};
+
+inline alloc_state_&
+alloc_state_of_(
+    void
+) {
+    static thread_local alloc_state_ s;
+    return s;
+}
+
+inline bool&
+alloc_tracker_installed_(
+    void
+) {
+    static bool installed = false;
+    return installed;
+}
+
+/* Whether the global operator new and delete have been
+ * replaced by defining QCXX_ALLOC_TRACKER before including
+ * this header, in exactly one translation unit.
+ */
+inline bool
+alloc_tracker_installed(
+    void
+) {
+    return alloc_tracker_installed_();
+}
+
+/* Every allocation is preceded by its size, so that freed
+ * bytes can be counted too.
+ */
+inline void*
+tracked_alloc_(
+    const std::size_t& n
+) {
+    const std::size_t h = alignof(std::max_align_t);
+    auto p = static_cast<unsigned char*>(std::malloc(n + h));
+    if (!p)
+        return nullptr;
+    *reinterpret_cast<std::size_t*>(p) = n;
+    
+    auto& s = alloc_state_of_();
+    if (s.tracking) {
+        s.count++;
+        s.bytes += n;
+        s.live += static_cast<std::ptrdiff_t>(n);
+        s.peak = std::max(s.peak, s.live);
+    }
+    return p + h;
+}
+
+inline void
+tracked_free_(
+    void* q
+) {
+    if (!q)
+        return;
+    
+    const std::size_t h = alignof(std::max_align_t);
+    auto p = static_cast<unsigned char*>(q) - h;
+    
+    auto& s = alloc_state_of_();
+    if (s.tracking)
+        s.live -= static_cast<std::ptrdiff_t>(
+            *reinterpret_cast<std::size_t*>(p));
+    std::free(p);
+}
+
+/* Track the allocations of the calling thread for the
+ * lifetime of the scope, which may be nested. Throws
+ * %std::logic_error if the allocation tracker has not been
+ * installed, see %alloc_tracker_installed().
+ */
+class alloc_scope
+{
+public:
+    alloc_scope(
+        void
+    ) :
+        state_(alloc_state_of_()),
+        saved_(alloc_state_of_())
+    {
+        if (!alloc_tracker_installed())
+            QCXX_THROW(std::logic_error,
+                "qcxx::alloc_scope: QCXX_ALLOC_TRACKER is not defined");
+        this->state_.tracking = true;
+        this->state_.scope = this;
+        this->state_.peak = this->state_.live;
+    }
+    
+    alloc_scope(
+        const alloc_scope&
+    ) = delete;
+    
+    alloc_scope&
+    operator=(
+        const alloc_scope&
+    ) = delete;
+    
+    ~alloc_scope(
+        void
+    ) {
+        this->state_.tracking = this->saved_.tracking;
+        this->state_.scope = this->saved_.scope;
+        this->state_.peak = std::max(this->state_.peak, this->saved_.peak);
+    }
+    
+    /* The allocations made in the scope so far.
+     */
+    alloc_stats
+    stats(
+        void
+    ) const {
+        alloc_stats a;
+        a.count = this->state_.count - this->saved_.count;
+        a.bytes = this->state_.bytes - this->saved_.bytes;
+        a.peak = static_cast<std::size_t>(
+            std::max<std::ptrdiff_t>(this->state_.peak - this->saved_.live, 0));
+        return a;
+    }
+    
+private:
+    alloc_state_& state_;
+    alloc_state_ saved_;
+};
+
+/* The allocations made so far in the innermost %alloc_scope
+ * of the calling thread. Properties open one around every
+ * call of %property::test() when the tracker is installed.
+ */
+inline alloc_stats
+current_allocs(
+    void
+) {
+    auto scope = alloc_state_of_().scope;
+    if (!scope)
+        QCXX_THROW(std::logic_error,
+            "qcxx::current_allocs: allocations are not tracked");
+    return scope->stats();
+}
+
+/* Fail the current test case if it has allocated so far, or
+ * allocated more than %_Bytes bytes, on the calling thread,
+ * see %current_allocs().
+ */
+#define EXPECT_NO_ALLOC()                                                   \
+    do {                                                                    \
+        if (qcxx::current_allocs().count)                                   \
+            return qcxx::result(qcxx::TEST_FAILURE);                        \
+    } while (0)
+
+#define EXPECT_ALLOC_BYTES_LE(_Bytes)                                       \
+    do {                                                                    \
+        if (qcxx::current_allocs().bytes >                                  \
+                static_cast<std::size_t>(_Bytes))                           \
+            return qcxx::result(qcxx::TEST_FAILURE);                        \
+    } while (0)
+
+/* A thread watching one test at a time, see %qc_config::timeout.
+ * A test still running at its deadline is flagged as expired,
+ * and one still running at its hang deadline is handed to the
+ * hang handler, which is not expected to return. The thread is
+ * started when a test is first watched.
+ */
+class watchdog
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+    
+    watchdog(
+        void
+    ) :
+        mutex_(),
+        cond_(),
+        thread_(),
+        epoch_(0),
+        armed_(false),
+        stopped_(false),
+        expired_(false),
+        deadline_(),
+        hang_deadline_(),
+        on_hang_()
+    {}
+    
+    watchdog(
+        const watchdog&
+    ) = delete;
+    
+    watchdog&
+    operator=(
+        const watchdog&
+    ) = delete;
+    
+    ~watchdog(
+        void
+    ) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->stopped_ = true;
+        }
+        this->cond_.notify_one();
+        if (this->thread_.joinable())
+            this->thread_.join();
+    }
+    
+    /* Watch a test which should return within %limit, calling
+     * %on_hang if it has not returned within %hang.
+     */
+    void
+    arm(
+        const std::chrono::nanoseconds& limit,
+        const std::chrono::nanoseconds& hang,
+        std::function<void()> on_hang
+    ) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            if (!this->thread_.joinable())
+                this->thread_ = std::thread([this] { this->run_(); });
+            
+            auto now = clock_type::now();
+            this->deadline_ = now + limit;
+            this->hang_deadline_ = now + hang;
+            this->on_hang_ = std::move(on_hang);
+            this->expired_ = false;
+            this->armed_ = true;
+            this->epoch_++;
+        }
+        this->cond_.notify_one();
+    }
+    
+    /* Stop watching the current test. The thread is not woken
+     * up, it notices at the deadline.
+     */
+    void
+    disarm(
+        void
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->armed_ = false;
+    }
+    
+    /* Whether the current test has run past its deadline.
+     */
+    bool
+    expired(
+        void
+    ) const {
+        return this->expired_.load(std::memory_order_relaxed);
+    }
+    
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+    std::uint64_t epoch_;
+    bool armed_;
+    bool stopped_;
+    std::atomic<bool> expired_;
+    clock_type::time_point deadline_;
+    clock_type::time_point hang_deadline_;
+    std::function<void()> on_hang_;
+    
+    void
+    run_(
+        void
+    ) {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        
+        while (!this->stopped_) {
+            if (!this->armed_) {
+                this->cond_.wait(lock);
+                continue;
+            }
+            
+            auto epoch = this->epoch_;
+            auto done = [this, epoch] {
+                return (
+                    this->stopped_ ||
+                    !this->armed_ ||
+                    this->epoch_ != epoch
+                );
+            };
+            if (this->cond_.wait_until(lock, this->deadline_, done))
+                continue;
+            this->expired_ = true;
+            if (this->cond_.wait_until(lock, this->hang_deadline_, done))
+                continue;
+            
+            auto on_hang = this->on_hang_;
+            lock.unlock();
+            on_hang();
+            return;
+        }
+    }
+};
+
+/* Write and read back counts by name, as sent by the child of
+ * an isolated run and saved in checkpoints.
+ */
+inline void
+put_counts_(
+    std::ostream& out,
+    const std::map<std::string, size_type>& counts
+) {
+    out << counts.size() << '\n';
+    for (const auto& c : counts)
+        out << c.second << ' ' << c.first.size() << '\n' << c.first << '\n';
+}
+
+inline bool
+get_counts_(
+    std::istream& in,
+    std::map<std::string, size_type>& counts
+) {
+    std::size_t n = 0;
+    if (!(in >> n))
+        return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        size_type count = 0;
+        std::size_t length = 0;
+        if (!(in >> count >> length) || in.get() != '\n')
+            return false;
+        std::string name(length, '\0');
+        if (!in.read(&name[0], static_cast<std::streamsize>(length)))
+            return false;
+        counts[name] += count;
+    }
+    return true;
+}
+
+/**
+ * %save_engine_()
+ * @{
+ */
+template
+<
+    typename Engine
+>
+auto
+save_engine_(
+    std::ostream& out,
+    const Engine& engine,
+    int
+) -> decltype((void)(out << engine), bool()) {
+    out << engine;
+    return true;
+}
+template
+<
+    typename Engine
+>
+bool
+save_engine_(
+    std::ostream&,
+    const Engine&,
+    long
+) {
+    return false;
+}
+/**
+ * @}
+ */
+
+/**
+ * %load_engine_()
+ * @{
+ */
+template
+<
+    typename Engine
+>
+auto
+load_engine_(
+    std::istream& in,
+    Engine& engine,
+    int
+) -> decltype((void)(in >> engine), bool()) {
+    return static_cast<bool>(in >> engine);
+}
+template
+<
+    typename Engine
+>
+bool
+load_engine_(
+    std::istream&,
+    Engine&,
+    long
+) {
+    return false;
+}
+/**
+ * @}
+ */
+
+#ifdef QCXX_HAVE_FORK
+/* The progress of the child process of an isolated run, kept
+ * in memory shared with the parent, see %qc_config::isolate.
+ */
+struct isolation_progress_
+{
+    std::uint64_t started;
+    std::uint64_t n_tests;
+    std::uint64_t n_discards;
+    std::uint64_t n_rejects;
+    bool testing;
+};
+
+/* The seed of the engine of the %w-th worker of a run with the
+ * seed %seed, see %qc_config::n_workers, mixed by SplitMix64 so
+ * that the workers draw unrelated values.
+ */
+inline seed_type
+worker_seed(
+    const seed_type& seed,
+    const std::size_t& w
+) {
+    std::uint64_t z = seed + 0x9e3779b97f4a7c15ULL * (w + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+inline void
+write_all_(
+    int fd,
+    const std::string& s
+) {
+    for (std::size_t i = 0; i < s.size(); ) {
+        auto n = ::write(fd, s.data() + i, s.size() - i);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+        i += static_cast<std::size_t>(n);
+    }
+}
+
+inline std::string
+read_all_(
+    int fd
+) {
+    std::string s;
+    char buffer[4096];
+    for (;;) {
+        auto n = ::read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return s;
+        s.append(buffer, static_cast<std::size_t>(n));
+    }
+}
+
+inline int
+wait_child_(
+    pid_t pid
+) {
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        ;
+    return status;
+}
+
+/* Why a child process ended with %status while running %what.
+ */
+inline std::string
+exit_reason_(
+    int status,
+    const std::string& what
+) {
+    if (WIFSIGNALED(status)) {
+        auto sig = WTERMSIG(status);
+        return what + " was killed by signal " + std::to_string(sig) +
+            " (" + ::strsignal(sig) + ")";
+    }
+    return what + " exited with status " +
+        std::to_string(WIFEXITED(status)? WEXITSTATUS(status): status);
+}
+
+/* Flush the standard streams, so that buffered output is not
+ * written again by a child process.
+ */
+inline void
+flush_streams_(
+    void
+) {
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+}
+#endif
+
+/* Base class for properties.
+ */
+template
+<
+    typename Engine,
+    typename... Params
+>
+class property
+{
+public:
+    typedef Engine engine_type;
+    typedef std::tuple<
+        Params...
+    > params_type;
+    
+    explicit
+    property(
+        engine_type& engine,
+        qc_config& conf
+    ) :
+        engine_(engine),
+        conf_(conf),
+        retries_(0),
+        n_case_labels_(0),
+        counters_(),
+        counts_(),
+        counting_(false),
+        last_allocs_(),
+        allocs_(),
+        timing_(false),
+        why_(),
+        last_elapsed_(0),
+        latency_(),
+        started_(),
+        reporter_(nullptr),
+        isolating_(false),
+        child_(false),
+        deadline_(),
+        resumed_(0),
+        progress_at_(),
+        progress_tests_(0),
+        progress_discards_(0),
+        tallied_(0),
+        sizing_(false),
+        size_(0),
+        shrinking_(false),
+        watchdog_()
+    {}
+    
+    virtual
+    ~property(
+        void
+    ) {
+    }
+    
+    virtual result
+    test(
+        Params...
+    ) = 0;
+    
+    typedef std::tuple<
+        std::list<Params>...
+    > candidates_type;
+    
+    /* Generate a value for every parameter, together with its
+     * shrunk values, see %PROPERTY_GENERATORS. Values rejected
+     * by %precondition() are generated again, and not shrunk.
+     */
+    virtual candidates_type
+    candidates(
+        void
+    ) {
+        for (;;) {
+            std::tuple<Params...> xs{
+                this->draw_(get_generator<Params>(this->engine()))...
+            };
+            if (!this->admissible_(xs, std::index_sequence_for<Params...>()))
+                this->reject_();
+            else if (this->sizing_)
+                return this->unshrunk_(xs, std::index_sequence_for<Params...>());
+            else
+                return this->minimize_(xs, std::index_sequence_for<Params...>());
+        }
+    }
+    
+    /* Override this, preferably using %PROPERTY_PRECONDITION, to
+     * reject values before they are shrunk and tested. Rejected
+     * values are generated again, up to %qc_config::max_retries
+     * times, which is much cheaper than discarding in %test().
+     */
+    virtual bool
+    precondition(
+        const Params&...
+    ) {
+        return true;
+    }
+    
+    /* Override this to prepare what the tests of a run share,
+     * once per property, before its first test, see
+     * %fixture_property. Isolated runs set up the property
+     * before forking, so that children start prepared.
+     */
+    virtual void
+    setup(
+        void
+    ) {
+    }
+    
+    /* Override this to restore, cheaply, what a test may have
+     * changed in the state shared by the tests. Called before
+     * every test, see %fixture_property.
+     */
+    virtual void
+    reset(
+        void
+    ) {
+    }
+    
+    /* Override this, preferably using %PROPERTY_WORKLOAD, to
+     * generate the values of the given size used when the
+     * property is benchmarked, see %benchmarkWith(). By default
+     * they are drawn by %candidates(), so from the generators of
+     * the property and satisfying its precondition, with the
+     * generators which take a size given %size, and are not
+     * shrunk.
+     */
+    virtual params_type
+    workload(
+        const std::size_t& size
+    ) {
+        this->sizing_ = true;
+        this->size_ = size;
+        candidates_type xs;
+        try {
+            xs = this->candidates();
+        } catch(...) {
+            this->sizing_ = false;
+            throw;
+        }
+        this->sizing_ = false;
+        
+        return this->first_(xs, std::index_sequence_for<Params...>());
+    }
+    
+    /* The maximum mean counts of hardware events per test, see
+     * %EXPECT_COUNTERS. Limits of events which can not be
+     * counted are ignored.
+     */
+    virtual std::vector<std::pair<counter, double>>
+    counter_limits(
+        void
+    ) const {
+        return {};
+    }
+    
+    /* The complexity class the cost of %test() must not
+     * exceed, see %EXPECT_COMPLEXITY and %checkComplexityWith().
+     */
+    virtual complexity
+    expected_complexity(
+        void
+    ) const {
+        return COMPLEXITY_ANY;
+    }
+    
+    /* Count %n abstract operations, such as comparisons, done
+     * by the current test. %checkComplexityWith() fits the
+     * operations of properties which count them instead of
+     * their times, which makes the fit deterministic.
+     */
+    void
+    tally(
+        const double& n = 1
+    ) {
+        this->tallied_ += n;
+    }
+    
+    /* The operations counted by %tally() so far.
+     */
+    double
+    tallied(
+        void
+    ) const {
+        return this->tallied_;
+    }
+    
+    /* The maximum quantiles of the time of %test() over the
+     * passed tests of a run, see %EXPECT_LATENCY.
+     */
+    virtual std::vector<std::pair<double, std::chrono::nanoseconds>>
+    latency_limits(
+        void
+    ) const {
+        return {};
+    }
+    
+    /* Whether the current test has run longer than
+     * %qc_config::timeout. Tests with long loops can poll this
+     * and return early, instead of being taken to hang.
+     */
+    bool
+    timed_out(
+        void
+    ) const {
+        if (this->child_) {
+            return (
+                this->conf_.timeout.count() > 0 &&
+                std::chrono::steady_clock::now() >= this->deadline_
+            );
+        }
+        return this->watchdog_.expired();
+    }
+    
+    /* The name used when reporting the property.
+     */
+    virtual std::string
+    name(
+        void
+    ) const {
+        return "property";
+    }
+    
+    /* Whether the run has failed and its counterexample is
+     * being shrunk, so that tests are no longer drawn from the
+     * distribution of the generators.
+     */
+    bool
+    shrinking(
+        void
+    ) const {
+        return this->shrinking_;
+    }
+    
+    virtual result
+    step(
+        const std::list<Params>&... xs
+    ) {
+        result r0 = this->precondition(*xs.begin()...)?
+            this->test_(
+                std::tuple<Params...>(this->data(xs)...),
+                std::index_sequence_for<Params...>()
+            ):
+            result(TEST_DISCARD);
+        auto why = r0 == TEST_FAILURE? this->why_: std::string();
+        auto wr = false;
+        
+        if (r0 == TEST_FAILURE) {
+            this->shrinking_ = true;
+            if (this->reducible(xs...)) {
+                auto r1 = this->step(
+                    this->reduce(xs)...
+                );
+                wr = (
+                    TEST_SUCCESS == r1 ||
+                    TEST_DISCARD == r1 ||
+                    TEST_NOTHING == r1
+                );
+            } else
+                wr = true;
+        }
+        if (wr)
+            this->fail_(
+                std::tuple<Params...>(this->data(xs)...),
+                why,
+                std::index_sequence_for<Params...>()
+            );
+        
+        return r0;
+    }
+    
+    /* Deprecated, the stream is ignored and the result goes to
+     * the report, see %step(const std::list<Params>&...).
+     * Overriding this no longer has any effect.
+     */
+    [[deprecated("use step(const std::list<Params>&...)")]]
+    virtual result
+    step(
+        std::ostream&,
+        const std::list<Params>&... xs
+    ) {
+        return this->step(xs...);
+    }
+    
+    virtual result
+    go(
+        reporter& rep
+    ) {
+        typedef std::chrono::steady_clock clock_type;
+        
+#ifdef QCXX_HAVE_FORK
+        if (this->config().isolate || this->config().n_workers > 1)
+            return this->go_forked_(
+                rep,
+                std::max<size_type>(this->config().n_workers, 1),
+                std::index_sequence_for<Params...>()
+            );
+#endif
+        
+        result r;
+        auto start = clock_type::now();
+        
+        this->open_report(&rep);
+        this->setup();
+        this->resume_();
+        
+        while (
+            this->config().again() &&
+            r != TEST_FAILURE &&
+            !this->soaked_()
+        ) {
+            this->n_case_labels_ = 0;
+            try {
+                auto xs = this->candidates();
+                r = this->step_(
+                    xs,
+                    std::index_sequence_for<Params...>()
+                );
+                if (r == TEST_SUCCESS) {
+                    this->count_add_(1);
+                    this->count_allocs_();
+                    this->count_latency_();
+                } else if (r == TEST_DISCARD) {
+                    this->config().discard_sites[
+                        r.where()? r.where(): "test"
+                    ]++;
+                }
+            } catch(const discarded& e) {
+                this->config().discard_sites[e.what()]++;
+                r = TEST_DISCARD;
+            } catch(const std::exception& e) {
+                this->report_.message = std::string(
+                    "caught exception: ") + e.what();
+                r = TEST_FAILURE;
+            } catch(...) {
+                this->report_.message = "caught exception";
+                r = TEST_FAILURE;
+            }
+            
+            switch (r) {
+            case TEST_SUCCESS:
+                this->config().n_tests++;
+                this->commit_labels_();
+                break;
+            case TEST_DISCARD:
+                this->config().n_discards++;
+                break;
+            default:
+                break;
+            }
+            this->tick_();
+        }
+        if (r != TEST_FAILURE && this->config().soak)
+            r = this->passed_();
+        else if (
+            r == TEST_NOTHING &&
+            (this->config().n_tests || this->config().n_discards)
+        )
+            r = this->passed_();
+        
+        return this->close_report(
+            rep,
+            r,
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds
+            >(clock_type::now() - start)
+        );
+    }
+    
+    /* Override this to add measurements to %rep when the run
+     * is done, see %report::metrics.
+     */
+    virtual void
+    summarize(
+        report&
+    ) {
+    }
+    
+    /* Start a new report, discarding the previous one. The
+     * report of a test which hangs is handed to %rep, if given,
+     * see %qc_config::timeout.
+     */
+    void
+    open_report(
+        reporter* rep = nullptr
+    ) {
+        this->report_ = report();
+        this->counts_.fill(histogram());
+        this->allocs_.fill(histogram());
+        this->latency_ = histogram();
+        this->timing_ = !this->latency_limits().empty();
+        this->started_ = std::chrono::steady_clock::now();
+        this->reporter_ = rep;
+        this->resumed_ = std::chrono::nanoseconds(0);
+        this->shrinking_ = false;
+        this->counting_ = (
+            this->config().count_events ||
+            !this->counter_limits().empty()
+        ) && this->counters_.open();
+    }
+    
+    /* Complete the current report of a run which ended with %r
+     * after %elapsed time, and hand it to %rep. A passing run
+     * fails if a class was not covered as required, or if the
+     * mean of a counted event exceeds its limit. Removes the
+     * checkpoint of the run, if any. Returns the final state of
+     * the run.
+     */
+    state
+    close_report(
+        reporter& rep,
+        const state& r,
+        const std::chrono::nanoseconds& elapsed
+    ) {
+        const auto& conf = this->config();
+        
+        this->report_.labels = sorted_counts_(conf.labels);
+        this->report_.coverage = conf.coverage;
+        this->report_.uncovered.clear();
+        
+        if (r == TEST_SUCCESS) {
+            for (const auto& c : conf.coverage) {
+                auto i = conf.labels.find(c.first);
+                auto n = i != conf.labels.end()? i->second: 0;
+                if (100.0 * n < c.second * conf.n_tests)
+                    this->report_.uncovered.push_back(c.first);
+            }
+        }
+        
+        this->report_.name = this->name();
+        this->report_.status = this->report_.uncovered.empty()?
+            r: TEST_FAILURE;
+        this->report_.n_tests = this->config().n_tests;
+        this->report_.n_discards = this->config().n_discards;
+        this->report_.n_rejects = this->config().n_rejects;
+        this->report_.discard_sites = sorted_counts_(conf.discard_sites);
+        this->report_.seed = this->config().seed;
+        this->report_.elapsed = elapsed + this->resumed_;
+        this->report_.metrics.clear();
+        this->summarize_counts_(this->report_);
+        this->summarize(this->report_);
+        
+        if (!conf.checkpoint.empty())
+            std::remove(conf.checkpoint.c_str());
+        rep(this->report_);
+        
+        return this->report_.status;
+    }
+    
+    /* Count the current test case as a member of the class
+     * %name. Only passed test cases are counted, and only once
+     * per class, see %qc_config::labels.
+     */
+    void
+    label(
+        const std::string& name
+    ) {
+        for (std::size_t i = 0; i < this->n_case_labels_; ++i) {
+            if (this->case_labels_[i] == name)
+                return;
+        }
+        if (this->n_case_labels_ == this->case_labels_.size())
+            this->case_labels_.push_back(name);
+        else
+            this->case_labels_[this->n_case_labels_] = name;
+        this->n_case_labels_++;
+    }
+    
+    /* Count the current test case as a member of the class
+     * %name if %condition holds.
+     */
+    void
+    classify(
+        const bool& condition,
+        const std::string& name
+    ) {
+        if (condition)
+            this->label(name);
+    }
+    
+    /* Count the current test case as a member of the class
+     * named after the shown value of %x.
+     */
+    template
+    <
+        typename Type
+    >
+    void
+    collect(
+        const Type& x
+    ) {
+        this->label(show_string(x));
+    }
+    
+    /* Like %classify(), but also require at least %percent of
+     * the passed test cases to be members of the class.
+     */
+    void
+    cover(
+        const double& percent,
+        const bool& condition,
+        const std::string& name
+    ) {
+        this->config().coverage[name] = percent;
+        this->classify(condition, name);
+    }
+    
+    virtual result
+    go(
+        std::ostream& out
+    ) {
+        text_reporter rep(out);
+        return this->go(rep);
+    }
+    
+    /* Record the given (shrunk) values as the counterexample.
+     */
+    virtual void
+    failure(
+        Params... xs
+    ) {
+        this->report_.counterexample = {
+            show_string(xs)...
+        };
+    }
+    
+    /* Deprecated, the stream is ignored and the counterexample
+     * goes to the report, see %failure(Params...). Overriding
+     * this no longer has any effect.
+     */
+    [[deprecated("use failure(Params...)")]]
+    virtual void
+    failure(
+        std::ostream&,
+        Params... xs
+    ) {
+        this->failure(xs...);
+    }
+    
+    /**
+     * %last_report()
+     * @{
+     */
+    const report&
+    last_report(
+        void
+    ) const {
+        return this->report_;
+    }
+    report&
+    last_report(
+        void
+    ) {
+        return this->report_;
+    }
+    /**
+     * @}
+     */
+    
+    /* Test the given values once, without shrinking them.
+     */
+    result
+    check(
+        const Params&... xs
+    ) {
+        this->n_case_labels_ = 0;
+        
+        result r = this->precondition(xs...)?
+            this->test_(
+                std::tuple<Params...>(xs...),
+                std::index_sequence_for<Params...>()
+            ):
+            result(TEST_DISCARD, "precondition");
+        
+        if (r == TEST_SUCCESS)
+            this->commit_labels_();
+        
+        return r;
+    }
+    
+    engine_type&
+    engine(
+        void
+    ) {
+        return this->engine_;
+    }
+    
+    qc_config&
+    config(
+        void
+    ) {
+        return this->conf_;
+    }
+    
+private:
+    engine_type& engine_;
+    qc_config& conf_;
+    report report_;
+    size_type retries_;
+    std::vector<std::string> case_labels_;
+    std::size_t n_case_labels_;
+    perf_counters counters_;
+    std::array<histogram, N_COUNTERS> counts_;
+    bool counting_;
+    alloc_stats last_allocs_;
+    std::array<histogram, 3> allocs_;
+    bool timing_;
+    std::string why_;
+    std::chrono::nanoseconds last_elapsed_;
+    histogram latency_;
+    std::chrono::steady_clock::time_point started_;
+    reporter* reporter_;
+    bool isolating_;
+    bool child_;
+    std::chrono::steady_clock::time_point deadline_;
+    std::chrono::nanoseconds resumed_;
+    std::chrono::steady_clock::time_point progress_at_;
+    size_type progress_tests_;
+    size_type progress_discards_;
+    double tallied_;
+    bool sizing_;
+    std::size_t size_;
+    bool shrinking_;
+    watchdog watchdog_;
+    
+    void
+    count_allocs_(
+        void
+    ) {
+        if (!this->config().count_allocs || !alloc_tracker_installed())
+            return;
+        this->allocs_[0].add(this->last_allocs_.count);
+        this->allocs_[1].add(this->last_allocs_.bytes);
+        this->allocs_[2].add(this->last_allocs_.peak);
+    }
+    
+    void
+    count_latency_(
+        void
+    ) {
+        if (this->timing_ || this->config().timeout.count() > 0)
+            this->latency_.add(this->last_elapsed_.count());
+    }
+    
+    void
+    summarize_counts_(
+        report& rep
+    ) {
+        for (int i = 0; i < N_COUNTERS; ++i) {
+            auto c = static_cast<counter>(i);
+            const auto& h = this->counts_[i];
+            if (!this->counters_.available(c) || !h.count())
+                continue;
+            
+            std::string name = counter_name(c);
+            rep.metrics.emplace_back(name + "_mean", h.mean());
+            rep.metrics.emplace_back(name + "_p50", h.quantile(0.5));
+            rep.metrics.emplace_back(name + "_p99", h.quantile(0.99));
+        }
+        
+        if (this->allocs_[0].count()) {
+            rep.metrics.emplace_back("allocs_mean", this->allocs_[0].mean());
+            rep.metrics.emplace_back("allocs_max", this->allocs_[0].max());
+            rep.metrics.emplace_back("alloc_bytes_mean", this->allocs_[1].mean());
+            rep.metrics.emplace_back("alloc_bytes_max", this->allocs_[1].max());
+            rep.metrics.emplace_back("alloc_peak_max", this->allocs_[2].max());
+        }
+        
+        if (this->latency_.count()) {
+            rep.metrics.emplace_back("test_p50_ns", this->latency_.quantile(0.5));
+            rep.metrics.emplace_back("test_p99_ns", this->latency_.quantile(0.99));
+            rep.metrics.emplace_back("test_max_ns", this->latency_.max());
+        }
+        
+        if (rep.status != TEST_SUCCESS)
+            return;
+        for (const auto& l : this->latency_limits()) {
+            auto q = static_cast<double>(this->latency_.quantile(l.first));
+            if (!this->latency_.count() || q <= l.second.count())
+                continue;
+            
+            std::ostringstream osstr;
+            osstr << "p"
+                  << 100 * l.first
+                  << " of test() was "
+                  << q
+                  << " ns, the limit is "
+                  << l.second.count()
+                  << " ns";
+            rep.status = TEST_FAILURE;
+            rep.message = osstr.str();
+            return;
+        }
+        for (const auto& l : this->counter_limits()) {
+            const auto& h = this->counts_[l.first];
+            if (!this->counters_.available(l.first) || !h.count() ||
+                    h.mean() <= l.second)
+                continue;
+            
+            std::ostringstream osstr;
+            osstr << counter_name(l.first)
+                  << " averaged "
+                  << h.mean()
+                  << " per test, the limit is "
+                  << l.second;
+            rep.status = TEST_FAILURE;
+            rep.message = osstr.str();
+            break;
+        }
+    }
+    
+    static std::vector<std::pair<std::string, size_type>>
+    sorted_counts_(
+        const std::map<std::string, size_type>& counts
+    ) {
+        std::vector<std::pair<std::string, size_type>> xs(
+            counts.begin(),
+            counts.end()
+        );
+        std::stable_sort(
+            xs.begin(),
+            xs.end(),
+            [](const auto& a, const auto& b) {
+                return a.second > b.second;
+            }
+        );
+        return xs;
+    }
+    
+    std::chrono::nanoseconds
+    elapsed_(
+        const std::chrono::steady_clock::time_point& now
+    ) const {
+        return std::chrono::duration_cast<
+            std::chrono::nanoseconds
+        >(now - this->started_) + this->resumed_;
+    }
+    
+    /* Save the progress of the run to %qc_config::checkpoint,
+     * through a temporary file renamed over the previous
+     * checkpoint so that an interrupted save leaves it intact.
+     * Nothing is saved if the engine cannot be written to a
+     * stream.
+     */
+    void
+    save_checkpoint_(
+        const std::chrono::nanoseconds& elapsed
+    ) {
+        const auto& conf = this->config();
+        const auto name = this->name();
+        
+        std::ostringstream out;
+        out << "qcxx-checkpoint 1\n"
+            << name.size() << '\n'
+            << name << '\n'
+            << conf.seed << ' '
+            << conf.n_tests << ' '
+            << conf.n_discards << ' '
+            << conf.n_rejects << ' '
+            << elapsed.count() << '\n';
+        put_counts_(out, conf.labels);
+        put_counts_(out, conf.discard_sites);
+        if (!save_engine_(out, this->engine(), 0))
+            return;
+        out << '\n';
+        
+        const auto path = conf.checkpoint + ".tmp";
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << out.str();
+        file.close();
+        if (!file || std::rename(path.c_str(), conf.checkpoint.c_str()))
+            QCXX_THROW(std::runtime_error,
+                "qcxx::property: cannot save the checkpoint");
+    }
+    
+protected:
+    /* Whether a soak run has run for %qc_config::soak_for.
+     */
+    bool
+    soaked_(
+        void
+    ) const {
+        const auto& conf = this->conf_;
+        return (
+            conf.soak &&
+            conf.soak_for.count() > 0 &&
+            this->elapsed_(std::chrono::steady_clock::now()) >=
+                conf.soak_for
+        );
+    }
+    
+    /* The state of a run which ended without a failure.
+     */
+    state
+    passed_(
+        void
+    ) const {
+        const auto& conf = this->conf_;
+        if (conf.soak)
+            return conf.again()? TEST_SUCCESS: TEST_DISCARD;
+        return conf.n_tests < conf.max_tests? TEST_DISCARD: TEST_SUCCESS;
+    }
+    
+    /* Resume the run from %qc_config::checkpoint if the file
+     * exists, restoring the counts, the elapsed time and the
+     * state of the engine, and start counting the progress.
+     */
+    void
+    resume_(
+        void
+    ) {
+        auto& conf = this->config();
+        
+        std::ifstream in;
+        if (!conf.checkpoint.empty())
+            in.open(conf.checkpoint, std::ios::binary);
+        if (in.is_open()) {
+            std::string magic;
+            int version = 0;
+            std::size_t length = 0;
+            if (
+                !(in >> magic >> version >> length) ||
+                magic != "qcxx-checkpoint" ||
+                version != 1 ||
+                in.get() != '\n'
+            )
+                QCXX_THROW(std::runtime_error,
+                    "qcxx::property: not a checkpoint");
+            
+            std::string name(length, '\0');
+            in.read(&name[0], static_cast<std::streamsize>(length));
+            if (name != this->name())
+                QCXX_THROW(std::runtime_error,
+                    "qcxx::property: checkpoint of another property");
+            
+            seed_type seed = 0;
+            size_type n_tests = 0;
+            size_type n_discards = 0;
+            size_type n_rejects = 0;
+            long long elapsed = 0;
+            std::map<std::string, size_type> labels;
+            std::map<std::string, size_type> sites;
+            engine_type engine = this->engine();
+            if (
+                !(in >> seed >> n_tests >> n_discards >> n_rejects >>
+                    elapsed) ||
+                !get_counts_(in, labels) ||
+                !get_counts_(in, sites) ||
+                !load_engine_(in, engine, 0)
+            )
+                QCXX_THROW(std::runtime_error,
+                    "qcxx::property: corrupt checkpoint");
+            
+            conf.seed = seed;
+            conf.n_tests = n_tests;
+            conf.n_discards = n_discards;
+            conf.n_rejects = n_rejects;
+            conf.labels = std::move(labels);
+            conf.discard_sites = std::move(sites);
+            this->engine() = engine;
+            this->resumed_ = std::chrono::nanoseconds(elapsed);
+        }
+        
+        this->progress_at_ = std::chrono::steady_clock::now();
+        this->progress_tests_ = conf.n_tests;
+        this->progress_discards_ = conf.n_discards;
+    }
+    
+    /* Save the checkpoint and hand the progress to the reporter
+     * once every %qc_config::progress_every, in soak runs and
+     * runs with a checkpoint.
+     */
+    void
+    tick_(
+        void
+    ) {
+        const auto& conf = this->config();
+        if (!conf.soak && conf.checkpoint.empty())
+            return;
+        auto now = std::chrono::steady_clock::now();
+        if (now - this->progress_at_ < conf.progress_every)
+            return;
+        
+        if (!conf.checkpoint.empty())
+            this->save_checkpoint_(this->elapsed_(now));
+        this->progress_(now);
+    }
+    
+    /* Hand the progress of the run since the last progress
+     * report to the reporter, if any.
+     */
+    void
+    progress_(
+        const std::chrono::steady_clock::time_point& now
+    ) {
+        const auto& conf = this->config();
+        
+        if (this->reporter_) {
+            auto s = std::chrono::duration<double>(
+                now - this->progress_at_).count();
+            auto rate = [s](const size_type& n) {
+                return s > 0? n / s: 0.0;
+            };
+            
+            report rep;
+            rep.name = this->name();
+            rep.n_tests = conf.n_tests;
+            rep.n_discards = conf.n_discards;
+            rep.n_rejects = conf.n_rejects;
+            rep.discard_sites = sorted_counts_(conf.discard_sites);
+            rep.labels = sorted_counts_(conf.labels);
+            rep.coverage = conf.coverage;
+            rep.seed = conf.seed;
+            rep.elapsed = this->elapsed_(now);
+            rep.metrics.emplace_back("tests_per_s",
+                rate(conf.n_tests - this->progress_tests_));
+            rep.metrics.emplace_back("discards_per_s",
+                rate(conf.n_discards - this->progress_discards_));
+            this->reporter_->progress(rep);
+            this->reporter_->flush();
+        }
+        
+        this->progress_at_ = now;
+        this->progress_tests_ = conf.n_tests;
+        this->progress_discards_ = conf.n_discards;
+    }
+    
+private:
+    void
+    commit_labels_(
+        void
+    ) {
+        for (std::size_t i = 0; i < this->n_case_labels_; ++i)
+            this->config().labels[this->case_labels_[i]]++;
+    }
+    
+protected:
+    /* Fail the current test, reporting %why instead of the usual
+     * message if its values are the counterexample.
+     */
+    result
+    fail_because(
+        const std::string& why
+    ) {
+        this->why_ = why;
+        return result(TEST_FAILURE);
+    }
+    
+    /* Reset the fixture and call %test() with %xs, timing the
+     * call if there is a timeout or a latency limit, see
+     * %qc_config::timeout. In the parent of an isolated run
+     * every call is made in a new child process, see
+     * %qc_config::isolate.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    result
+    test_(
+        std::tuple<Params...> xs,
+        std::index_sequence<I...> seq
+    ) {
+        typedef std::chrono::steady_clock clock_type;
+        
+        this->why_.clear();
+#ifdef QCXX_HAVE_FORK
+        if (this->isolating_)
+            return this->isolate_(xs, seq);
+#endif
+        
+        this->reset();
+        const auto timeout = this->config().timeout;
+        const auto watched = timeout.count() > 0;
+        if (!watched && !this->timing_)
+            return this->call_(xs, seq);
+        
+        if (watched)
+            this->watch_(xs, seq);
+        auto start = clock_type::now();
+        result r;
+        try {
+            r = this->call_(xs, seq);
+        } catch(...) {
+            if (watched)
+                this->unwatch_();
+            throw;
+        }
+        this->last_elapsed_ = std::chrono::duration_cast<
+            std::chrono::nanoseconds
+        >(clock_type::now() - start);
+        if (watched)
+            this->unwatch_();
+        
+        if (watched && this->last_elapsed_ > timeout) {
+            this->why_ = this->timeout_reason_(false);
+            return result(TEST_FAILURE);
+        }
+        return r;
+    }
+    
+    /* Watch the test of %xs, with the watchdog, or in a child
+     * process with a timer killing it when it hangs. The
+     * watchdog is handed the report of the hang and a copy of
+     * %xs beforehand, so that it does not touch the property or
+     * the values under test, and only shows the copy if the
+     * test hangs.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    void
+    watch_(
+        const std::tuple<Params...>& xs,
+        std::index_sequence<I...>
+    ) {
+        const auto timeout = this->config().timeout;
+        this->deadline_ = std::chrono::steady_clock::now() + timeout;
+#ifdef QCXX_HAVE_FORK
+        if (this->child_) {
+            auto us = std::max<long long>(1, std::chrono::duration_cast<
+                std::chrono::microseconds
+            >(10 * timeout).count());
+            itimerval t;
+            t.it_interval.tv_sec = 0;
+            t.it_interval.tv_usec = 0;
+            t.it_value.tv_sec = static_cast<time_t>(us / 1000000);
+            t.it_value.tv_usec = static_cast<suseconds_t>(us % 1000000);
+            ::setitimer(ITIMER_REAL, &t, nullptr);
+            return;
+        }
+#endif
+        const auto& conf = this->config();
+        report snapshot;
+        snapshot.name = this->name();
+        snapshot.status = TEST_FAILURE;
+        snapshot.n_tests = conf.n_tests;
+        snapshot.n_discards = conf.n_discards;
+        snapshot.n_rejects = conf.n_rejects;
+        snapshot.seed = conf.seed;
+        snapshot.message = this->timeout_reason_(true);
+        
+        auto kept = std::make_shared<const std::tuple<Params...>>(xs);
+        auto rep = this->reporter_;
+        auto started = this->started_ - this->resumed_;
+        this->watchdog_.arm(
+            timeout,
+            10 * timeout,
+            [snapshot, kept, rep, started]() mutable {
+                snapshot.counterexample = {
+                    show_string(std::get<I>(*kept))...
+                };
+                hang_(snapshot, rep, started);
+            }
+        );
+    }
+    
+    void
+    unwatch_(
+        void
+    ) {
+#ifdef QCXX_HAVE_FORK
+        if (this->child_) {
+            itimerval t;
+            std::memset(&t, 0, sizeof(t));
+            ::setitimer(ITIMER_REAL, &t, nullptr);
+            return;
+        }
+#endif
+        this->watchdog_.disarm();
+    }
+    
+    /* Why a test failed for taking too long, or for not
+     * returning at all if %hung.
+     */
+    std::string
+    timeout_reason_(
+        bool hung
+    ) {
+        const auto ns = this->config().timeout.count();
+        return hung?
+            "test() did not return within " + std::to_string(10 * ns) + " ns":
+            "test() exceeded the timeout of " + std::to_string(ns) + " ns";
+    }
+    
+    /* Call %test() with %xs, tracking its allocations if the
+     * allocation tracker is installed, see %current_allocs(),
+     * and counting its hardware events, which %count_add_() then
+     * records. The fixture must have been reset already.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    result
+    call_(
+        std::tuple<Params...>& xs,
+        std::index_sequence<I...>
+    ) {
+        if (!alloc_tracker_installed()) {
+            this->count_start_();
+            auto r = this->test(std::move(std::get<I>(xs))...);
+            this->count_stop_(0);
+            return r;
+        }
+        
+        alloc_scope scope;
+        this->count_start_();
+        auto r = this->test(std::move(std::get<I>(xs))...);
+        this->count_stop_(0);
+        this->last_allocs_ = scope.stats();
+        return r;
+    }
+    
+    /* Hand %snapshot, the report of a run whose test did not
+     * return, to %rep, or to the standard error if none, and
+     * terminate the process. Called by the watchdog thread
+     * while the test is still running, so only the snapshot
+     * and copies made by %watch_() are touched.
+     */
+    static void
+    hang_(
+        report& snapshot,
+        reporter* rep,
+        const std::chrono::steady_clock::time_point& started
+    ) {
+        snapshot.elapsed = std::chrono::duration_cast<
+            std::chrono::nanoseconds
+        >(std::chrono::steady_clock::now() - started);
+        
+        text_reporter fallback(std::cerr);
+        auto& out = rep? *rep: fallback;
+        out(snapshot);
+        out.flush();
+        std::_Exit(EXIT_FAILURE);
+    }
+#ifdef QCXX_HAVE_FORK
+    
+    /* Exit codes of the children testing one value each, see
+     * %isolate_().
+     */
+    static constexpr int CODE_STATE_ = 100;
+    static constexpr int CODE_TIMEOUT_ = 110;
+    
+    /* Test %xs in a new child process, failing if it crashes.
+     * The message of an exception thrown by the test is sent
+     * back through a pipe and becomes the reason of the failure.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    result
+    isolate_(
+        std::tuple<Params...>& xs,
+        std::index_sequence<I...> seq
+    ) {
+        int p[2];
+        if (::pipe(p))
+            QCXX_THROW(std::runtime_error, "qcxx::property: pipe failed");
+        flush_streams_();
+        auto pid = ::fork();
+        if (pid < 0) {
+            ::close(p[0]);
+            ::close(p[1]);
+            QCXX_THROW(std::runtime_error, "qcxx::property: fork failed");
+        }
+        
+        if (!pid) {
+            ::close(p[0]);
+            this->isolating_ = false;
+            this->child_ = true;
+            int code = CODE_STATE_ + TEST_FAILURE;
+            try {
+                auto r = this->test_(std::move(xs), seq);
+                code = this->why_.empty()?
+                    CODE_STATE_ + static_cast<state>(r): CODE_TIMEOUT_;
+            } catch(const discarded&) {
+                code = CODE_STATE_ + TEST_DISCARD;
+            } catch(const std::exception& e) {
+                write_all_(p[1], std::string("caught exception: ") + e.what());
+            } catch(...) {
+                write_all_(p[1], "caught exception");
+            }
+            ::close(p[1]);
+            flush_streams_();
+            std::_Exit(code);
+        }
+        
+        ::close(p[1]);
+        auto message = read_all_(p[0]);
+        ::close(p[0]);
+        auto status = wait_child_(pid);
+        if (WIFEXITED(status)) {
+            auto code = WEXITSTATUS(status);
+            if (code == CODE_STATE_ + TEST_FAILURE && !message.empty()) {
+                this->why_ = message;
+                return result(TEST_FAILURE);
+            }
+            if (code >= CODE_STATE_ && code <= CODE_STATE_ + TEST_NOTHING)
+                return result(static_cast<state>(code - CODE_STATE_));
+            if (code == CODE_TIMEOUT_) {
+                this->why_ = this->timeout_reason_(false);
+                return result(TEST_FAILURE);
+            }
+        }
+        this->why_ = this->hung_(status)?
+            this->timeout_reason_(true):
+            exit_reason_(status, "test()");
+        return result(TEST_FAILURE);
+    }
+    
+    /* Whether a child ended with %status was killed by the
+     * timer set in %watch_().
+     */
+    bool
+    hung_(
+        int status
+    ) {
+        return (
+            this->config().timeout.count() > 0 &&
+            WIFSIGNALED(status) &&
+            WTERMSIG(status) == SIGALRM
+        );
+    }
+    
+    /* Run the tests in %n child processes forked once the
+     * property has been set up, see %qc_config::isolate and
+     * %qc_config::n_workers. With more than one worker, every
+     * worker runs its share of the tests with its own seed. Once
+     * a worker fails or crashes, the others are stopped, and the
+     * values of the failing test which came earliest in its
+     * worker are generated again and shrunk in fresh children.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    result
+    go_forked_(
+        reporter& rep,
+        const std::size_t& n,
+        std::index_sequence<I...> seq
+    ) {
+        typedef std::chrono::steady_clock clock_type;
+        
+        auto& conf = this->config();
+        auto start = clock_type::now();
+        
+        this->open_report(&rep);
+        this->setup();
+        
+        const auto size = n * sizeof(isolation_progress_);
+        void* shared = ::mmap(
+            nullptr,
+            size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_ANONYMOUS,
+            -1,
+            0
+        );
+        if (shared == MAP_FAILED)
+            QCXX_THROW(std::runtime_error, "qcxx::property: mmap failed");
+        auto progress = static_cast<isolation_progress_*>(shared);
+        for (std::size_t w = 0; w < n; ++w)
+            new (progress + w) isolation_progress_();
+        
+        std::vector<pid_t> pids(n, -1);
+        std::vector<int> fds(n, -1);
+        std::vector<int> statuses(n, 0);
+        std::vector<bool> stopped(n, false);
+        std::vector<std::string> records(n);
+        auto stop = [&](const std::size_t& except) {
+            for (std::size_t w = 0; w < n; ++w) {
+                if (w != except && pids[w] > 0 && !stopped[w]) {
+                    ::kill(pids[w], SIGKILL);
+                    stopped[w] = true;
+                }
+            }
+        };
+        
+        flush_streams_();
+        for (std::size_t w = 0; w < n; ++w) {
+            int p[2];
+            pid_t pid = -1;
+            if (!::pipe(p)) {
+                pid = ::fork();
+                if (pid < 0) {
+                    ::close(p[0]);
+                    ::close(p[1]);
+                }
+            }
+            if (pid < 0) {
+                stop(n);
+                for (std::size_t v = 0; v < w; ++v) {
+                    ::close(fds[v]);
+                    wait_child_(pids[v]);
+                }
+                ::munmap(shared, size);
+                QCXX_THROW(std::runtime_error,
+                    "qcxx::property: cannot start the workers");
+            }
+            if (!pid) {
+                for (std::size_t v = 0; v < w; ++v)
+                    ::close(fds[v]);
+                ::close(p[0]);
+                this->child_ = true;
+                if (n > 1)
+                    this->shard_(w, n);
+                this->search_(progress[w], p[1], seq);
+            }
+            ::close(p[1]);
+            fds[w] = p[0];
+            pids[w] = pid;
+        }
+        
+        this->progress_at_ = clock_type::now();
+        this->progress_tests_ = 0;
+        this->progress_discards_ = 0;
+        for (auto n_open = n; n_open; ) {
+            if (conf.soak) {
+                auto now = clock_type::now();
+                if (now - this->progress_at_ >= conf.progress_every) {
+                    conf.n_tests = 0;
+                    conf.n_discards = 0;
+                    conf.n_rejects = 0;
+                    for (std::size_t w = 0; w < n; ++w) {
+                        conf.n_tests += progress[w].n_tests;
+                        conf.n_discards += progress[w].n_discards;
+                        conf.n_rejects += progress[w].n_rejects;
+                    }
+                    this->progress_(now);
+                }
+            }
+            
+            std::vector<pollfd> polled;
+            std::vector<std::size_t> workers;
+            for (std::size_t w = 0; w < n; ++w) {
+                if (fds[w] >= 0) {
+                    polled.push_back(pollfd{fds[w], POLLIN, 0});
+                    workers.push_back(w);
+                }
+            }
+            int wait = -1;
+            if (conf.soak) {
+                auto left = std::chrono::duration_cast<
+                    std::chrono::milliseconds
+                >(this->progress_at_ + conf.progress_every - clock_type::now());
+                wait = static_cast<int>(std::min<long long>(
+                    std::max<long long>(left.count() + 1, 0),
+                    std::numeric_limits<int>::max()
+                ));
+            }
+            if (::poll(polled.data(), polled.size(), wait) < 0) {
+                if (errno == EINTR)
+                    continue;
+                stop(n);
+                for (auto w : workers) {
+                    records[w] += read_all_(fds[w]);
+                    ::close(fds[w]);
+                    fds[w] = -1;
+                    statuses[w] = wait_child_(pids[w]);
+                }
+                break;
+            }
+            
+            for (std::size_t k = 0; k < polled.size(); ++k) {
+                const auto w = workers[k];
+                if (!polled[k].revents)
+                    continue;
+                char buffer[4096];
+                auto m = ::read(fds[w], buffer, sizeof(buffer));
+                if (m < 0 && errno == EINTR)
+                    continue;
+                if (m > 0) {
+                    records[w].append(buffer, static_cast<std::size_t>(m));
+                    continue;
+                }
+                
+                ::close(fds[w]);
+                fds[w] = -1;
+                n_open--;
+                statuses[w] = wait_child_(pids[w]);
+                auto passed = (
+                    WIFEXITED(statuses[w]) && !WEXITSTATUS(statuses[w]) &&
+                    std::atoi(records[w].c_str()) != TEST_FAILURE
+                );
+                if (!passed && !stopped[w])
+                    stop(w);
+            }
+        }
+        
+        std::vector<isolation_progress_> done(progress, progress + n);
+        ::munmap(shared, size);
+        
+        conf.n_tests = 0;
+        conf.n_discards = 0;
+        conf.n_rejects = 0;
+        auto failure = n;
+        std::string why;
+        for (std::size_t w = 0; w < n; ++w) {
+            std::istringstream record(records[w]);
+            int s = TEST_NOTHING;
+            size_type n_tests = 0;
+            size_type n_discards = 0;
+            size_type n_rejects = 0;
+            auto complete = (
+                WIFEXITED(statuses[w]) && !WEXITSTATUS(statuses[w]) &&
+                record >> s >> n_tests >> n_discards >> n_rejects &&
+                get_counts_(record, conf.labels) &&
+                get_counts_(record, conf.discard_sites)
+            );
+            if (!complete) {
+                n_tests = done[w].n_tests;
+                n_discards = done[w].n_discards;
+                n_rejects = done[w].n_rejects;
+            }
+            conf.n_tests += n_tests;
+            conf.n_discards += n_discards;
+            conf.n_rejects += n_rejects;
+            
+            if (complete? s != TEST_FAILURE: stopped[w])
+                continue;
+            if (failure < n && done[failure].started <= done[w].started)
+                continue;
+            failure = w;
+            why = complete? std::string():
+                this->hung_(statuses[w])? this->timeout_reason_(true):
+                exit_reason_(statuses[w],
+                    done[w].testing? "test()": "generation");
+        }
+        
+        result r = failure < n? TEST_FAILURE:
+            conf.n_tests || conf.n_discards? this->passed_(): TEST_NOTHING;
+        if (failure < n && done[failure].testing) {
+            if (n > 1)
+                this->engine().seed(static_cast<
+                    typename engine_type::result_type
+                >(worker_seed(conf.seed, failure)));
+            this->replay_(done[failure].started, why, seq);
+        } else if (failure < n) {
+            this->report_.message = why.empty()? "caught exception": why;
+        }
+        
+        return this->close_report(
+            rep,
+            r,
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds
+            >(clock_type::now() - start)
+        );
+    }
+    
+    /* Make this child the %w-th of %n workers: give it its share
+     * of the tests and discards, and seed its engine with
+     * %worker_seed().
+     */
+    void
+    shard_(
+        const std::size_t& w,
+        const std::size_t& n
+    ) {
+        auto& conf = this->config();
+        auto share = [&](const size_type& total) {
+            return total * (w + 1) / n - total * w / n;
+        };
+        conf.max_tests = share(conf.max_tests);
+        conf.max_discards = std::max<size_type>(share(conf.max_discards), 1);
+        this->engine().seed(static_cast<
+            typename engine_type::result_type
+        >(worker_seed(conf.seed, w)));
+    }
+    
+    /* Generate the values of the %n-th test again, and shrink
+     * them with one child per test. %why tells how the child
+     * running every test ended, if it crashed.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    void
+    replay_(
+        const std::uint64_t& n,
+        const std::string& why,
+        std::index_sequence<I...> seq
+    ) {
+        auto& conf = this->config();
+        const auto n_rejects = conf.n_rejects;
+        
+        try {
+            for (std::uint64_t i = 1; i < n; ++i) {
+                try {
+                    this->candidates();
+                } catch(const discarded&) {
+                }
+            }
+            auto xs = this->candidates();
+            conf.n_rejects = n_rejects;
+            
+            this->isolating_ = true;
+            auto r = this->step_(xs, seq);
+            this->isolating_ = false;
+            
+            if (r != TEST_FAILURE) {
+                this->failure(this->data(std::get<I>(xs))...);
+                this->report_.message = (
+                    why.empty()? "test() failed": why
+                ) + " after other tests in the same process, but not alone";
+            }
+        } catch(const std::exception& e) {
+            this->isolating_ = false;
+            this->report_.message = std::string(
+                "caught exception: ") + e.what();
+        } catch(...) {
+            this->isolating_ = false;
+            this->report_.message = "caught exception";
+        }
+    }
+    
+    /* Run the tests in the child process of an isolated run,
+     * until one fails, recording the progress in %progress and
+     * writing the counts to %fd when done.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    void
+    search_(
+        isolation_progress_& progress,
+        int fd,
+        std::index_sequence<I...>
+    ) {
+        auto& conf = this->config();
+        result r;
+        
+        while (conf.again() && r != TEST_FAILURE && !this->soaked_()) {
+            progress.started++;
+            progress.testing = false;
+            try {
+                auto xs = this->candidates();
+                progress.testing = true;
+                r = this->check(this->data(std::get<I>(xs))...);
+                if (r == TEST_DISCARD)
+                    conf.discard_sites[r.where()? r.where(): "test"]++;
+            } catch(const discarded& e) {
+                conf.discard_sites[e.what()]++;
+                r = TEST_DISCARD;
+            } catch(...) {
+                r = TEST_FAILURE;
+            }
+            
+            switch (r) {
+            case TEST_SUCCESS:
+                conf.n_tests++;
+                break;
+            case TEST_DISCARD:
+                conf.n_discards++;
+                break;
+            default:
+                break;
+            }
+            progress.n_tests = conf.n_tests;
+            progress.n_discards = conf.n_discards;
+            progress.n_rejects = conf.n_rejects;
+        }
+        
+        std::ostringstream out;
+        out << static_cast<int>(static_cast<state>(r)) << ' '
+            << conf.n_tests << ' '
+            << conf.n_discards << ' '
+            << conf.n_rejects << '\n';
+        put_counts_(out, conf.labels);
+        put_counts_(out, conf.discard_sites);
+        write_all_(fd, out.str());
+        ::close(fd);
+        
+        flush_streams_();
+        std::_Exit(EXIT_SUCCESS);
+    }
+#endif
+    
+    /* Count hardware events from %count_start_() to
+     * %count_stop_(), for %n tests, if enabled, see
+     * %qc_config::count_events. With no tests the counts are
+     * kept for %count_add_().
+     */
+    void
+    count_start_(
+        void
+    ) {
+        if (this->counting_)
+            this->counters_.start();
+    }
+    
+    void
+    count_stop_(
+        const std::size_t& n
+    ) {
+        if (this->counting_)
+            this->counters_.stop();
+        this->count_add_(n);
+    }
+    
+    void
+    count_add_(
+        const std::size_t& n
+    ) {
+        if (!this->counting_ || !n)
+            return;
+        for (int i = 0; i < N_COUNTERS; ++i) {
+            this->counts_[i].add(
+                this->counters_.value(static_cast<counter>(i)) / n
+            );
+        }
+    }
+    
+    /* Sample the given generators, one per parameter.
+     */
+    template
+    <
+        typename... Generators
+    >
+    candidates_type
+    sample_all(
+        Generators&&... gens
+    ) {
+        for (;;) {
+            candidates_type xs{
+                this->sample_sized_(gens)...
+            };
+            if (this->admissible_(xs, std::index_sequence_for<Params...>()))
+                return xs;
+            this->reject_();
+        }
+    }
+    
+    /* Count a value rejected by %precondition(), discarding the
+     * test case when it has been retried too many times.
+     */
+    void
+    reject_(
+        void
+    ) {
+        if (++this->retries_ >= this->config().max_retries) {
+            this->retries_ = 0;
+            throw discarded("precondition");
+        }
+        this->config().n_rejects++;
+    }
+    
+    /**
+     * %admissible_()
+     * @{
+     */
+    template
+    <
+        std::size_t... I
+    >
+    bool
+    admissible_(
+        const std::tuple<Params...>& xs,
+        std::index_sequence<I...>
+    ) {
+        return this->admitted_(this->precondition(std::get<I>(xs)...));
+    }
+    template
+    <
+        std::size_t... I
+    >
+    bool
+    admissible_(
+        const candidates_type& xs,
+        std::index_sequence<I...>
+    ) {
+        return this->admitted_(this->precondition(std::get<I>(xs).front()...));
+    }
+    /**
+     * @}
+     */
+    
+    bool
+    admitted_(
+        const bool& ok
+    ) {
+        if (ok)
+            this->retries_ = 0;
+        return ok;
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    candidates_type
+    minimize_(
+        const std::tuple<Params...>& xs,
+        std::index_sequence<I...>
+    ) {
+        return candidates_type{
+            get_minimizer<Params>(this->engine())(std::get<I>(xs))...
+        };
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    candidates_type
+    unshrunk_(
+        const std::tuple<Params...>& xs,
+        std::index_sequence<I...>
+    ) {
+        return candidates_type{
+            std::list<Params>{std::get<I>(xs)}...
+        };
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    params_type
+    first_(
+        const candidates_type& xs,
+        std::index_sequence<I...>
+    ) {
+        return params_type{
+            this->data(std::get<I>(xs))...
+        };
+    }
+    
+    /* Draw a value from %gen, of the size of the workload being
+     * generated if any, see %workload().
+     */
+    template
+    <
+        typename Generator
+    >
+    typename std::decay<Generator>::type::value_type
+    draw_(
+        Generator&& gen
+    ) {
+        return this->sizing_? sized_(gen, this->size_, 0): gen();
+    }
+    
+    /* Sample %gen, or draw a single value of the size of the
+     * workload being generated if any.
+     */
+    template
+    <
+        typename Generator
+    >
+    std::list<typename std::decay<Generator>::type::value_type>
+    sample_sized_(
+        Generator& gen
+    ) {
+        if (!this->sizing_)
+            return sample(gen);
+        return {sized_(gen, this->size_, 0)};
+    }
+    
+    /* Shrink the counterexample %xs further, one parameter after
+     * the other, and report it, with the reason %why if the
+     * failure was not decided by %test() itself.
+     */
+    template
+    <
+        std::size_t... I
+    >
+    void
+    fail_(
+        std::tuple<Params...> xs,
+        std::string why,
+        std::index_sequence<I...>
+    ) {
+        size_type budget = this->config().max_shrinks;
+        (void)std::initializer_list<int>{
+            (this->refine_<I>(xs, budget, why, 0), 0)...
+        };
+        if (!why.empty())
+            this->report_.message = why;
+        this->failure(std::get<I>(xs)...);
+    }
+    
+    /**
+     * %refine_()
+     * @{
+     */
+    template
+    <
+        std::size_t I
+    >
+    auto
+    refine_(
+        std::tuple<Params...>& xs,
+        size_type& budget,
+        std::string& why,
+        int
+    ) -> decltype((void) get_minimizer<
+        typename std::tuple_element<I, params_type>::type
+    >(std::declval<engine_type&>()).shrinks(std::get<I>(xs))) {
+        typedef typename std::tuple_element<I, params_type>::type type;
+        
+        auto min = get_minimizer<type>(this->engine());
+        
+        for (auto progress = true; progress && budget; ) {
+            progress = false;
+            auto consider = [&](type x) {
+                if (!budget)
+                    return false;
+                budget--;
+                auto ys = xs;
+                std::get<I>(ys) = std::move(x);
+                if (this->falsifies_(ys, std::index_sequence_for<Params...>())) {
+                    why = this->why_;
+                    xs = std::move(ys);
+                    progress = true;
+                    return false;
+                }
+                return true;
+            };
+            each_shrink_(min, std::get<I>(xs), consider, 0);
+        }
+    }
+    template
+    <
+        std::size_t I
+    >
+    void
+    refine_(
+        std::tuple<Params...>&,
+        size_type&,
+        std::string&,
+        long
+    ) {
+    }
+    /**
+     * @}
+     */
+    
+    /* Give the shrinks of %x to %consider until it returns
+     * false, walking them in place if %min can, see
+     * %subtree_minimizer::shrinks().
+     */
+    /**
+     * %each_shrink_()
+     * @{
+     */
+    template
+    <
+        typename Minimizer,
+        typename Type,
+        typename Consider
+    >
+    static auto
+    each_shrink_(
+        Minimizer& min,
+        const Type& x,
+        Consider& consider,
+        int
+    ) -> decltype((void) min.shrinks(
+        x,
+        std::function<bool(const Type&)>()
+    )) {
+        min.shrinks(x, std::function<bool(const Type&)>(consider));
+    }
+    template
+    <
+        typename Minimizer,
+        typename Type,
+        typename Consider
+    >
+    static void
+    each_shrink_(
+        Minimizer& min,
+        const Type& x,
+        Consider& consider,
+        long
+    ) {
+        for (auto& y : min.shrinks(x))
+            if (!consider(std::move(y)))
+                break;
+    }
+    /**
+     * @}
+     */
+    
+    /* Whether %xs is admissible and fails, exceptions other than
+     * %discarded being failures as in %go().
+     */
+    template
+    <
+        std::size_t... I
+    >
+    bool
+    falsifies_(
+        const std::tuple<Params...>& xs,
+        std::index_sequence<I...>
+    ) {
+        this->why_.clear();
+        try {
+            return (
+                this->precondition(std::get<I>(xs)...) &&
+                this->test_(xs, std::index_sequence_for<Params...>()) ==
+                    TEST_FAILURE
+            );
+        } catch(const discarded&) {
+            return false;
+        } catch(...) {
+            return true;
+        }
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    result
+    step_(
+        const candidates_type& xs,
+        std::index_sequence<I...>
+    ) {
+        return this->step(std::get<I>(xs)...);
+    }
+    
+    template
+    <
+        typename Container
+    >
+    typename Container::value_type
+    data(
+        const Container& c
+    ) {
+        return *c.begin();
+    }
+    
+    template
+    <
+        typename Container
+    >
+    Container
+    reduce(
+        const Container& c
+    ) {
+        return Container(++c.begin(), c.end());
+    }
+    
+    /**
+     * %reducible()
+     * @{
+     */
+    template
+    <
+        typename Container
+    >
+    bool
+    reducible(
+        const Container& c
+    ) {
+        return c.size() > 1;
+    }
+    template
+    <
+        typename Container,
+        typename... Args
+    >
+    bool
+    reducible(
+        const Container& c,
+        const Args&... cs
+    ) {
+        return this->reducible(c) && this->reducible(cs...);
+    }
+    /**
+     * @}
+     */
+    
+};
+
+#define BEGIN_PROPERTY_TYPE_(_Name, _Base, ...)                             \
+    template                                                                \
+    <                                                                       \
+        typename Engine                                                     \
+    >                                                                       \
+    class _Name :                                                           \
+        public _Base<                                                       \
+            Engine,                                                         \
+            __VA_ARGS__                                                     \
+        >                                                                   \
+    {                                                                       \
+    public:                                                                 \
+        typedef _Base<                                                      \
+            Engine,                                                         \
+            __VA_ARGS__                                                     \
+        > property_type;                                                    \
+                                                                            \
+        explicit                                                            \
+        _Name(                                                              \
+            Engine& engine,                                                 \
+            qcxx::qc_config& conf                                           \
+        ) :                                                                 \
+            _Base<                                                          \
+                Engine,                                                     \
+                __VA_ARGS__                                                 \
+            >(engine, conf)                                                 \
+        {}                                                                  \
+                                                                            \
+        virtual std::string                                                 \
+        name(                                                               \
+            void                                                            \
+        ) const {                                                           \
+            return #_Name;                                                  \
+        }
+
+#define BEGIN_PROPERTY_TYPE(_Name, ...)                                     \
+    BEGIN_PROPERTY_TYPE_(_Name, qcxx::property, __VA_ARGS__)
+
+#define END_PROPERTY_TYPE                                                   \
+    };
+
+/* Use the given generators, one per parameter, instead of the
+ * %arbitrary ones. Values are shrunk as described by %sample().
+ */
+#define PROPERTY_GENERATORS(...)                                            \
+    virtual typename property_type::candidates_type                         \
+    candidates(                                                             \
+        void                                                                \
+    ) {                                                                     \
+        return this->sample_all(                                            \
+            __VA_ARGS__                                                     \
+        );                                                                  \
+    }
+
+/* Declare the precondition of the property, taking every
+ * parameter by const reference, see %property::precondition().
+ */
+#define PROPERTY_PRECONDITION(...)                                          \
+    virtual bool                                                            \
+    precondition(                                                           \
+        __VA_ARGS__                                                         \
+    ) override
+
+/* Declare the maximum mean counts of hardware events per
+ * test, or per lane of a batch, as pairs of a %counter and a
+ * number, like %EXPECT_COUNTERS({qcxx::COUNTER_CACHE_MISSES, 2}).
+ */
+#define EXPECT_COUNTERS(...)                                                \
+    virtual std::vector<std::pair<qcxx::counter, double>>                   \
+    counter_limits(                                                         \
+        void                                                                \
+    ) const override {                                                      \
+        return {__VA_ARGS__};                                               \
+    }
+
+/* Declare the maximum quantiles of the time of %test() over
+ * the passed tests of a run, as pairs of a quantile and a
+ * duration, like %EXPECT_LATENCY({0.99, std::chrono::microseconds(50)}).
+ */
+#define EXPECT_LATENCY(...)                                                 \
+    virtual std::vector<std::pair<double, std::chrono::nanoseconds>>        \
+    latency_limits(                                                         \
+        void                                                                \
+    ) const override {                                                      \
+        return {__VA_ARGS__};                                               \
+    }
+
+/* Declare the complexity class of the property, written like
+ * %EXPECT_COMPLEXITY(n log n), see %complexity_of().
+ */
+#define EXPECT_COMPLEXITY(...)                                              \
+    virtual qcxx::complexity                                                \
+    expected_complexity(                                                    \
+        void                                                                \
+    ) const override {                                                      \
+        return qcxx::complexity_of(#__VA_ARGS__);                           \
+    }
+
+#define PROPERTY_WORKLOAD(_Size)                                            \
+    virtual typename property_type::params_type                             \
+    workload(                                                               \
+        const std::size_t& _Size                                            \
+    ) override
+
+#define PROPERTY_METHOD(...)                                                \
+    virtual qcxx::result                                                    \
+    test(                                                                   \
+        __VA_ARGS__                                                         \
+    )
+
+/* Base class for properties tested a batch of values at a
+ * time, for cheap properties where calling %test() for every
+ * value would cost more than the test itself. %test_batch()
+ * receives one contiguous vector of values per parameter, and
+ * sets the %state of every lane of the mask; lanes it leaves
+ * alone are counted as discards. Failing lanes are shrunk and
+ * reported one at a time through %test(), which tests a batch
+ * of a single lane. Batches are generated by %generate(), of
+ * up to %qc_config::batch_size lanes. Labels are not counted.
+ */
+template
+<
+    typename Engine,
+    typename... Params
+>
+class batch_property :
+    public property<
+        Engine,
+        Params...
+    >
+{
+public:
+    typedef property<
+        Engine,
+        Params...
+    > property_type;
+    typedef std::tuple<
+        std::vector<Params>...
+    > batch_type;
+    typedef std::vector<
+        std::uint8_t
+    > mask_type;
+    
+    explicit
+    batch_property(
+        Engine& engine,
+        qc_config& conf
+    ) :
+        property_type(engine, conf)
+    {}
+    
+    virtual void
+    test_batch(
+        const batch_type& xs,
+        mask_type& mask
+    ) = 0;
+    
+    virtual result
+    test(
+        Params... xs
+    ) {
+        batch_type b{
+            std::vector<Params>(1, xs)...
+        };
+        mask_type mask(1, TEST_NOTHING);
+        this->test_batch(b, mask);
+        return result(static_cast<state>(mask[0]));
+    }
+    
+    /* Fill %xs with %n values per parameter, generated by the
+     * %arbitrary generators and checked by %precondition().
+     */
+    virtual void
+    generate(
+        batch_type& xs,
+        const std::size_t& n
+    ) {
+        auto gens = std::make_tuple(
+            get_generator<Params>(this->engine())...
+        );
+        this->generate_(xs, gens, n, std::index_sequence_for<Params...>());
+    }
+    
+    virtual result
+    go(
+        reporter& rep
+    ) {
+        typedef std::chrono::steady_clock clock_type;
+        
+        result r;
+        auto start = clock_type::now();
+        batch_type xs;
+        mask_type mask;
+        
+        this->open_report(&rep);
+        this->setup();
+        this->resume_();
+        
+        while (
+            this->config().again() &&
+            r != TEST_FAILURE &&
+            !this->soaked_()
+        ) {
+            auto& conf = this->config();
+            auto n = std::max<size_type>(conf.batch_size, 1);
+            if (!conf.soak)
+                n = std::min<size_type>(n, conf.max_tests - conf.n_tests);
+            
+            try {
+                this->generate(xs, n);
+                mask.assign(n, TEST_NOTHING);
+                this->count_start_();
+                this->test_batch(xs, mask);
+                this->count_stop_(n);
+                
+                for (std::size_t i = 0; i < n && r != TEST_FAILURE; ++i) {
+                    switch (mask[i]) {
+                    case TEST_SUCCESS:
+                        conf.n_tests++;
+                        break;
+                    case TEST_FAILURE:
+                        r = this->step_(
+                            this->minimize_(
+                                this->lane_(xs, i, std::index_sequence_for<Params...>()),
+                                std::index_sequence_for<Params...>()
+                            ),
+                            std::index_sequence_for<Params...>()
+                        );
+                        if (r != TEST_FAILURE)
+                            conf.n_tests++;
+                        break;
+                    default:
+                        conf.n_discards++;
+                        conf.discard_sites["test"]++;
+                        break;
+                    }
+                }
+            } catch(const discarded& e) {
+                conf.n_discards++;
+                conf.discard_sites[e.what()]++;
+            } catch(const std::exception& e) {
+                this->last_report().message = std::string(
+                    "caught exception: ") + e.what();
+                r = TEST_FAILURE;
+            } catch(...) {
+                this->last_report().message = "caught exception";
+                r = TEST_FAILURE;
+            }
+            this->tick_();
+        }
+        
+        return this->close_report(
+            rep,
+            r == TEST_FAILURE? TEST_FAILURE: this->passed_(),
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds
+            >(clock_type::now() - start)
+        );
+    }
+    
+protected:
+    template
+    <
+        typename Generators,
+        std::size_t... I
+    >
+    void
+    generate_(
+        batch_type& xs,
+        Generators& gens,
+        const std::size_t& n,
+        std::index_sequence<I...>
+    ) {
+        (void)std::initializer_list<int>{
+            (std::get<I>(xs).clear(), std::get<I>(xs).reserve(n), 0)...
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            for (;;) {
+                std::tuple<Params...> x{
+                    std::get<I>(gens)()...
+                };
+                if (this->admissible_(x, std::index_sequence_for<Params...>())) {
+                    (void)std::initializer_list<int>{
+                        (std::get<I>(xs).push_back(std::move(std::get<I>(x))), 0)...
+                    };
+                    break;
+                }
+                this->reject_();
+            }
+        }
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    std::tuple<Params...>
+    lane_(
+        const batch_type& xs,
+        const std::size_t& i,
+        std::index_sequence<I...>
+    ) {
+        return std::tuple<Params...>{
+            std::get<I>(xs)[i]...
+        };
+    }
+};
+
+#define BEGIN_BATCH_PROPERTY_TYPE(_Name, ...)                               \
+    BEGIN_PROPERTY_TYPE_(_Name, qcxx::batch_property, __VA_ARGS__)
+
+/* Declare the batch test of a property started with
+ * %BEGIN_BATCH_PROPERTY_TYPE, see %batch_property.
+ */
+#define PROPERTY_BATCH_METHOD(_Batch, _Mask)                                \
+    virtual void                                                            \
+    test_batch(                                                             \
+        const typename property_type::batch_type& _Batch,                   \
+        typename property_type::mask_type& _Mask                            \
+    )
+
+#ifdef QCXX_HAVE_COROUTINES
+/* Settings for %async_property: how long, on the virtual clock
+ * of its %event_loop, a test may take before it fails.
+ */
+struct async_config
+{
+    async_config(
+        void
+    ) :
+        timeout(std::chrono::seconds(60))
+    {}
+    
+    std::chrono::nanoseconds timeout;
+};
+
+/* The settings used by the async properties when none are given
+ * explicitly.
+ */
+inline async_config&
+async_settings(
+    void
+) {
+    static async_config conf;
+    return conf;
+}
+
+template
+<
+    typename Type
+>
+class task;
+
+struct task_final_awaiter_
+{
+    bool
+    await_ready(
+        void
+    ) const noexcept {
+        return false;
+    }
+    
+    template
+    <
+        typename Promise
+    >
+    std::coroutine_handle<>
+    await_suspend(
+        std::coroutine_handle<Promise> h
+    ) const noexcept {
+        auto next = h.promise().continuation;
+        return next? next: std::noop_coroutine();
+    }
+    
+    void
+    await_resume(
+        void
+    ) const noexcept {
+    }
+};
+
+class task_promise_base_
+{
+public:
+    task_promise_base_(
+        void
+    ) :
+        continuation(),
+        error()
+    {}
+    
+    std::suspend_always
+    initial_suspend(
+        void
+    ) const noexcept {
+        return {};
+    }
+    
+    task_final_awaiter_
+    final_suspend(
+        void
+    ) const noexcept {
+        return {};
+    }
+    
+    void
+    unhandled_exception(
+        void
+    ) {
+        this->error = std::current_exception();
+    }
+    
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+};
+
+template
+<
+    typename Type
+>
+class task_promise_ :
+    public task_promise_base_
+{
+public:
+    task<Type>
+    get_return_object(
+        void
+    );
+    
+    void
+    return_value(
+        Type x
+    ) {
+        this->value.emplace(std::move(x));
+    }
+    
+    Type
+    take(
+        void
+    ) {
+        if (this->error)
+            std::rethrow_exception(this->error);
+        return std::move(*this->value);
+    }
+    
+    std::optional<Type> value;
+};
+
+template
+<
+>
+class task_promise_<void> :
+    public task_promise_base_
+{
+public:
+    task<void>
+    get_return_object(
+        void
+    );
+    
+    void
+    return_void(
+        void
+    ) {
+    }
+    
+    void
+    take(
+        void
+    ) {
+        if (this->error)
+            std::rethrow_exception(this->error);
+    }
+};
+
+/* A lazily started coroutine returning %Type, started when it
+ * is awaited or spawned on an %event_loop, and resuming its
+ * awaiter when it returns. Exceptions propagate to the awaiter.
+ */
+template
+<
+    typename Type
+>
+class task
+{
+public:
+    typedef task_promise_<Type> promise_type;
+    typedef std::coroutine_handle<promise_type> handle_type;
+    
+    explicit
+    task(
+        handle_type h
+    ) :
+        h_(h)
+    {}
+    
+    task(
+        task&& t
+    ) noexcept :
+        h_(std::exchange(t.h_, nullptr))
+    {}
+    
+    task&
+    operator=(
+        task&& t
+    ) noexcept {
+        if (this != &t) {
+            if (this->h_)
+                this->h_.destroy();
+            this->h_ = std::exchange(t.h_, nullptr);
+        }
+        return *this;
+    }
+    
+    ~task(
+        void
+    ) {
+        if (this->h_)
+            this->h_.destroy();
+    }
+    
+    bool
+    done(
+        void
+    ) const {
+        return !this->h_ || this->h_.done();
+    }
+    
+    handle_type
+    handle(
+        void
+    ) const {
+        return this->h_;
+    }
+    
+    bool
+    await_ready(
+        void
+    ) const noexcept {
+        return this->h_.done();
+    }
+    
+    std::coroutine_handle<>
+    await_suspend(
+        std::coroutine_handle<> awaiter
+    ) noexcept {
+        this->h_.promise().continuation = awaiter;
+        return this->h_;
+    }
+    
+    Type
+    await_resume(
+        void
+    ) {
+        return this->h_.promise().take();
+    }
+    
+private:
+    handle_type h_;
+};
+
+template
+<
+    typename Type
+>
+task<Type>
+task_promise_<Type>::get_return_object(
+    void
+) {
+    return task<Type>(task<Type>::handle_type::from_promise(*this));
+}
+
+inline task<void>
+task_promise_<void>::get_return_object(
+    void
+) {
+    return task<void>(task<void>::handle_type::from_promise(*this));
+}
+
+/* A single-threaded event loop with a virtual clock, on which
+ * %async_property runs its tests. Coroutines suspended on
+ * %sleep_for() or %sleep_until() resume in the order of their
+ * deadlines, the clock jumping to the next deadline whenever
+ * nothing else is ready, so that no time is spent sleeping.
+ * The loop being constructed is the %current() one of its
+ * thread until it is destroyed.
+ */
+class event_loop
+{
+public:
+    typedef std::chrono::nanoseconds duration;
+    
+    class sleep_awaiter
+    {
+    public:
+        sleep_awaiter(
+            event_loop& loop,
+            const duration& when
+        ) :
+            loop_(loop),
+            when_(when)
+        {}
+        
+        bool
+        await_ready(
+            void
+        ) const noexcept {
+            return false;
+        }
+        
+        void
+        await_suspend(
+            std::coroutine_handle<> h
+        ) {
+            if (this->when_ <= this->loop_.now())
+                this->loop_.post(h);
+            else
+                this->loop_.post_at(this->when_, h);
+        }
+        
+        void
+        await_resume(
+            void
+        ) const noexcept {
+        }
+        
+    private:
+        event_loop& loop_;
+        duration when_;
+    };
+    
+    event_loop(
+        void
+    ) :
+        now_(0),
+        ready_(),
+        timers_(),
+        tasks_(),
+        previous_(current_())
+    {
+        current_() = this;
+    }
+    
+    event_loop(
+        const event_loop&
+    ) = delete;
+    
+    event_loop&
+    operator=(
+        const event_loop&
+    ) = delete;
+    
+    ~event_loop(
+        void
+    ) {
+        current_() = this->previous_;
+    }
+    
+    /* The innermost loop of the calling thread.
+     */
+    static event_loop&
+    current(
+        void
+    ) {
+        if (!current_())
+            QCXX_THROW(std::logic_error,
+                "qcxx::event_loop::current: no event loop");
+        return *current_();
+    }
+    
+    /* The virtual time, starting at zero.
+     */
+    duration
+    now(
+        void
+    ) const {
+        return this->now_;
+    }
+    
+    /* Resume %h once the coroutines ready before it have run.
+     */
+    void
+    post(
+        std::coroutine_handle<> h
+    ) {
+        this->ready_.push_back(h);
+    }
+    
+    /* Resume %h at the virtual time %when.
+     */
+    void
+    post_at(
+        const duration& when,
+        std::coroutine_handle<> h
+    ) {
+        this->timers_.emplace(when, h);
+    }
+    
+    sleep_awaiter
+    sleep_until(
+        const duration& when
+    ) {
+        return sleep_awaiter(*this, when);
+    }
+    
+    sleep_awaiter
+    sleep_for(
+        const duration& d
+    ) {
+        return sleep_awaiter(*this, this->now_ + d);
+    }
+    
+    /* Let the other ready coroutines run, without advancing the
+     * clock.
+     */
+    sleep_awaiter
+    yield(
+        void
+    ) {
+        return sleep_awaiter(*this, this->now_);
+    }
+    
+    /* Start %t, keeping it alive as long as the loop.
+     */
+    void
+    spawn(
+        task<void> t
+    ) {
+        this->post(t.handle());
+        this->tasks_.push_back(std::move(t));
+    }
+    
+    /* Run the loop until nothing is ready before the virtual
+     * time %deadline, returning whether all spawned tasks are
+     * done.
+     */
+    bool
+    run_until(
+        const duration& deadline
+    ) {
+        for (;;) {
+            while (!this->ready_.empty()) {
+                auto h = this->ready_.front();
+                this->ready_.pop_front();
+                h.resume();
+            }
+            if (
+                this->timers_.empty() ||
+                this->timers_.begin()->first > deadline
+            )
+                break;
+            
+            this->now_ = this->timers_.begin()->first;
+            while (
+                !this->timers_.empty() &&
+                this->timers_.begin()->first == this->now_
+            ) {
+                this->ready_.push_back(this->timers_.begin()->second);
+                this->timers_.erase(this->timers_.begin());
+            }
+        }
+        
+        for (const auto& t : this->tasks_)
+            if (!t.done())
+                return false;
+        return true;
+    }
+    
+    /* Whether no coroutine is waiting for the loop, so that an
+     * unfinished task is waiting for something that never
+     * happens.
+     */
+    bool
+    idle(
+        void
+    ) const {
+        return this->ready_.empty() && this->timers_.empty();
+    }
+    
+private:
+    duration now_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::multimap<duration, std::coroutine_handle<>> timers_;
+    std::vector<task<void>> tasks_;
+    event_loop* previous_;
+    
+    static event_loop*&
+    current_(
+        void
+    ) {
+        static thread_local event_loop* loop = nullptr;
+        return loop;
+    }
+};
+
+/* Base class for properties of asynchronous code, whose test
+ * %test_async() is a coroutine. Every batch of generated values
+ * runs concurrently on a new %event_loop, one task per value,
+ * so that tests waiting on the virtual clock overlap. A test
+ * fails if it throws, or if it has not returned once
+ * %async_config::timeout has passed on the virtual clock.
+ * Failing values are shrunk one at a time through %test(),
+ * which tells why they failed. See %batch_property.
+ */
+template
+<
+    typename Engine,
+    typename... Params
+>
+class async_property :
+    public batch_property<
+        Engine,
+        Params...
+    >
+{
+public:
+    typedef batch_property<
+        Engine,
+        Params...
+    > batch_property_type;
+    typedef typename batch_property_type::batch_type batch_type;
+    typedef typename batch_property_type::mask_type mask_type;
+    
+    explicit
+    async_property(
+        Engine& engine,
+        qc_config& conf,
+        const async_config& async = async_settings()
+    ) :
+        batch_property_type(engine, conf),
+        async_(async)
+    {}
+    
+    virtual task<result>
+    test_async(
+        Params... xs
+    ) = 0;
+    
+    virtual void
+    test_batch(
+        const batch_type& xs,
+        mask_type& mask
+    ) {
+        const auto n = mask.size();
+        std::vector<outcome_> outcomes(n);
+        {
+            event_loop loop;
+            for (std::size_t i = 0; i < n; ++i)
+                loop.spawn(this->settle_(
+                    this->start_(xs, i, std::index_sequence_for<Params...>()),
+                    outcomes[i]
+                ));
+            loop.run_until(this->async_.timeout);
+        }
+        
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& o = outcomes[i];
+            auto s = static_cast<state>(o.r);
+            if (o.discarded)
+                s = TEST_DISCARD;
+            else if (!o.done || o.error)
+                s = TEST_FAILURE;
+            mask[i] = s;
+        }
+    }
+    
+    virtual result
+    test(
+        Params... xs
+    ) {
+        outcome_ o;
+        auto idle = false;
+        {
+            event_loop loop;
+            loop.spawn(this->settle_(this->test_async(xs...), o));
+            loop.run_until(this->async_.timeout);
+            idle = loop.idle();
+        }
+        
+        if (o.error) {
+            try {
+                std::rethrow_exception(o.error);
+            } catch(const std::exception& e) {
+                return this->fail_because(
+                    std::string("caught exception: ") + e.what());
+            } catch(...) {
+                return this->fail_because("caught exception");
+            }
+        }
+        if (!o.done)
+            return this->fail_because(idle?
+                "test_async() never completed, with nothing left to "
+                    "resume it":
+                "test_async() did not complete within " +
+                    std::to_string(this->async_.timeout.count()) +
+                    " ns of virtual time");
+        return o.r;
+    }
+    
+private:
+    struct outcome_
+    {
+        outcome_(
+            void
+        ) :
+            r(),
+            error(),
+            done(false),
+            discarded(false)
+        {}
+        
+        result r;
+        std::exception_ptr error;
+        bool done;
+        bool discarded;
+    };
+    
+    async_config async_;
+    
+    static task<void>
+    settle_(
+        task<result> t,
+        outcome_& o
+    ) {
+        try {
+            o.r = co_await t;
+        } catch(const discarded&) {
+            o.discarded = true;
+        } catch(...) {
+            o.error = std::current_exception();
+        }
+        o.done = true;
+    }
+    
+    template
+    <
+        std::size_t... I
+    >
+    task<result>
+    start_(
+        const batch_type& xs,
+        const std::size_t& i,
+        std::index_sequence<I...>
+    ) {
+        return this->test_async(std::get<I>(xs)[i]...);
+    }
+};
+
+#define BEGIN_ASYNC_PROPERTY_TYPE(_Name, ...)                               \
+    BEGIN_PROPERTY_TYPE_(_Name, qcxx::async_property, __VA_ARGS__)
+
+/* Declare the coroutine testing a property started with
+ * %BEGIN_ASYNC_PROPERTY_TYPE, see %async_property.
+ */
+#define PROPERTY_ASYNC_METHOD(...)                                          \
+    virtual qcxx::task<qcxx::result>                                        \
+    test_async(                                                             \
+        __VA_ARGS__                                                         \
+    ) override
+#endif
+
+/* Base class for properties comparing an optimized
+ * implementation with a reference one. %test() calls both on
+ * the same values, timing each of them, and passes if
+ * %equivalent() holds for their outputs. The timings of every
+ * call until shrinking starts are kept in one histogram per
+ * side, summarized in the report as percentiles and the
+ * speedups of the optimized side at the median, at the 99th
+ * percentile and over the total times.
+ */
+template
+<
+    typename Engine,
+    typename Output,
+    typename... Params
+>
+class differential_property :
+    public property<
+        Engine,
+        Params...
+    >
+{
+public:
+    typedef property<
+        Engine,
+        Params...
+    > property_type;
+    typedef Output output_type;
+    
+    explicit
+    differential_property(
+        Engine& engine,
+        qc_config& conf
+    ) :
+        property_type(engine, conf),
+        reference_timings_(),
+        optimized_timings_(),
+        n_calls_(0)
+    {}
+    
+    using property_type::go;
+    
+    /* Run the property, timing it afresh.
+     */
+    virtual result
+    go(
+        reporter& rep
+    ) {
+        this->reference_timings_ = histogram();
+        this->optimized_timings_ = histogram();
+        this->n_calls_ = 0;
+        return property_type::go(rep);
+    }
+    
+    virtual Output
+    reference(
+        const Params&...
+    ) = 0;
+    
+    virtual Output
+    optimized(
+        const Params&...
+    ) = 0;
+    
+    /* Override this, preferably using %PROPERTY_EQUIVALENCE, to
+     * compare outputs other than with ==.
+     */
+    virtual bool
+    equivalent(
+        const Output& a,
+        const Output& b
+    ) {
+        return a == b;
+    }
+    
+    /* Call both implementations, every other time the
+     * optimized one first, so that neither side always runs on
+     * caches and allocator state warmed by the other.
+     */
+    virtual result
+    test(
+        Params... xs
+    ) {
+        typedef std::chrono::steady_clock clock_type;
+        
+        if (this->n_calls_++ % 2) {
+            auto t0 = clock_type::now();
+            auto b = this->optimized(xs...);
+            auto t1 = clock_type::now();
+            auto a = this->reference(xs...);
+            auto t2 = clock_type::now();
+            
+            this->record_(t2 - t1, t1 - t0);
+            return this->equivalent(a, b);
+        }
+        
+        auto t0 = clock_type::now();
+        auto a = this->reference(xs...);
+        auto t1 = clock_type::now();
+        auto b = this->optimized(xs...);
+        auto t2 = clock_type::now();
+        
+        this->record_(t1 - t0, t2 - t1);
+        return this->equivalent(a, b);
+    }
+    
+    virtual void
+    summarize(
+        report& rep
+    ) {
+        const auto& a = this->reference_timings_;
+        const auto& b = this->optimized_timings_;
+        if (!a.count())
+            return;
+        
+        auto ratio = [](const double& x, const double& y) {
+            return y > 0? x / y: std::numeric_limits<double>::infinity();
+        };
+        
+        rep.metrics.emplace_back("reference_p50_ns", a.quantile(0.5));
+        rep.metrics.emplace_back("reference_p99_ns", a.quantile(0.99));
+        rep.metrics.emplace_back("optimized_p50_ns", b.quantile(0.5));
+        rep.metrics.emplace_back("optimized_p99_ns", b.quantile(0.99));
+        rep.metrics.emplace_back("speedup_p50",
+            ratio(a.quantile(0.5), b.quantile(0.5)));
+        rep.metrics.emplace_back("speedup_p99",
+            ratio(a.quantile(0.99), b.quantile(0.99)));
+        rep.metrics.emplace_back("speedup",
+            ratio(static_cast<double>(a.sum()), static_cast<double>(b.sum())));
+    }
+    
+    const histogram&
+    reference_timings(
+        void
+    ) const {
+        return this->reference_timings_;
+    }
+    
+    const histogram&
+    optimized_timings(
+        void
+    ) const {
+        return this->optimized_timings_;
+    }
+    
+private:
+    histogram reference_timings_;
+    histogram optimized_timings_;
+    size_type n_calls_;
+    
+    template
+    <
+        typename Duration
+    >
+    void
+    record_(
+        const Duration& reference,
+        const Duration& optimized
+    ) {
+        if (!this->shrinking()) {
+            this->reference_timings_.add(nanoseconds_(reference));
+            this->optimized_timings_.add(nanoseconds_(optimized));
+        }
+    }
+    
+    template
+    <
+        typename Duration
+    >
+    static std::uint64_t
+    nanoseconds_(
+        const Duration& d
+    ) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()
+        );
+    }
+};
+
+/* Start a differential property, see %differential_property,
+ * whose implementations return %_Output for the parameters.
+ */
+#define BEGIN_DIFFERENTIAL_PROPERTY_TYPE(_Name, _Output, ...)               \
+    BEGIN_PROPERTY_TYPE_(                                                   \
+        _Name,                                                              \
+        qcxx::differential_property,                                        \
+        _Output,                                                            \
+        __VA_ARGS__                                                         \
+    )
+
+#define PROPERTY_REFERENCE(...)                                             \
+    virtual typename property_type::output_type                             \
+    reference(                                                              \
+        __VA_ARGS__                                                         \
+    ) override
+
+#define PROPERTY_OPTIMIZED(...)                                             \
+    virtual typename property_type::output_type                             \
+    optimized(                                                              \
+        __VA_ARGS__                                                         \
+    ) override
+
+#define PROPERTY_EQUIVALENCE(...)                                           \
+    virtual bool                                                            \
+    equivalent(                                                             \
+        __VA_ARGS__                                                         \
+    ) override
+
+/* Base class for properties sharing an expensive fixture, like
+ * a loaded index or a warmed cache, between their tests. The
+ * fixture is constructed by %setup(), or on first use, once
+ * per property, that is once per run and once per worker of
+ * an exhaustive run, and destroyed with the property. It is
+ * constructed with the engine of the property if it can be.
+ * Its %reset() method, if any, is called before every test to
+ * undo, cheaply, what the previous test changed.
+ */
+template
+<
+    typename Engine,
+    typename Fixture,
+    typename... Params
+>
+class fixture_property :
+    public property<
+        Engine,
+        Params...
+    >
+{
+public:
+    typedef property<
+        Engine,
+        Params...
+    > property_type;
+    typedef Fixture fixture_type;
+    
+    explicit
+    fixture_property(
+        Engine& engine,
+        qc_config& conf
+    ) :
+        property_type(engine, conf),
+        fixture_()
+    {}
+    
+    virtual void
+    setup(
+        void
+    ) {
+        this->fixture();
+    }
+    
+    virtual void
+    reset(
+        void
+    ) {
+        if (this->fixture_)
+            this->reset_(*this->fixture_, 0);
+    }
+    
+    /* The fixture, constructed on first use.
+     */
+    Fixture&
+    fixture(
+        void
+    ) {
+        if (!this->fixture_) {
+            this->fixture_ = this->make_(
+                std::is_constructible<Fixture, Engine&>()
+            );
+        }
+        return *this->fixture_;
+    }
+    
+private:
+    std::unique_ptr<Fixture> fixture_;
+    
+    /**
+     * %make_()
+     * @{
+     */
+    std::unique_ptr<Fixture>
+    make_(
+        std::true_type
+    ) {
+        return std::unique_ptr<Fixture>(new Fixture(this->engine()));
+    }
+    std::unique_ptr<Fixture>
+    make_(
+        std::false_type
+    ) {
+        return std::unique_ptr<Fixture>(new Fixture());
+    }
+    /**
+     * @}
+     */
+    
+    /**
+     * %reset_()
+     * @{
+     */
+    template
+    <
+        typename Type
+    >
+    auto
+    reset_(
+        Type& f,
+        int
+    ) -> decltype((void)f.reset()) {
+        f.reset();
+    }
+    template
+    <
+        typename Type
+    >
+    void
+    reset_(
+        Type&,
+        long
+    ) {
+    }
+    /**
+     * @}
+     */
+};
+
+/* Start a property using a fixture of type %_Fixture, see
+ * %fixture_property.
+ */
+#define BEGIN_FIXTURE_PROPERTY_TYPE(_Name, _Fixture, ...)                   \
+    BEGIN_PROPERTY_TYPE_(                                                   \
+        _Name,                                                              \
+        qcxx::fixture_property,                                             \
+        _Fixture,                                                           \
+        __VA_ARGS__                                                         \
+    )
+
+/* Base class for model-based tests of stateful systems, like
+ * caches, allocators or queues. Every test runs a generated
+ * sequence of commands against a new %System and a new %Model
+ * of it: commands which %allowed() rejects in the current state
+ * of the model are skipped, the others are applied to the
+ * system with %run() and to the model with %next(), and their
+ * outputs must satisfy %postcondition(). Failing sequences are
+ * shrunk by removing commands, see %commands_minimizer.
+ * Commands are generated with their own generators, see
+ * %arbitrary, and are run in place, so that the only
+ * allocations are those of the system and the model.
+ */
+template
+<
+    typename Engine,
+    typename Model,
+    typename System,
+    typename Command,
+    typename Output
+>
+class stateful_property :
+    public property<
+        Engine,
+        commands<Command>
+    >
+{
+public:
+    typedef property<
+        Engine,
+        commands<Command>
+    > property_type;
+    typedef Model model_type;
+    typedef System system_type;
+    typedef Command command_type;
+    typedef Output output_type;
+    
+    explicit
+    stateful_property(
+        Engine& engine,
+        qc_config& conf
+    ) :
+        property_type(engine, conf)
+    {}
+    
+    /* Override this, preferably using %PROPERTY_ALLOWED, to skip
+     * commands which can not be run in the state of %model.
+     */
+    virtual bool
+    allowed(
+        const Model&,
+        const Command&
+    ) {
+        return true;
+    }
+    
+    /* Run %command against the system, returning its output.
+     */
+    virtual Output
+    run(
+        System& system,
+        const Command& command
+    ) = 0;
+    
+    /* Apply %command to the model, returning the expected
+     * output.
+     */
+    virtual Output
+    next(
+        Model& model,
+        const Command& command
+    ) = 0;
+    
+    /* Override this, preferably using %PROPERTY_POSTCONDITION,
+     * to compare outputs other than with ==.
+     */
+    virtual bool
+    postcondition(
+        const Command&,
+        const Output& actual,
+        const Output& expected
+    ) {
+        return actual == expected;
+    }
+    
+    virtual result
+    test(
+        commands<Command> xs
+    ) {
+        Model model;
+        System system;
+        
+        for (const auto& x : xs) {
+            if (!this->allowed(model, x))
+                continue;
+            auto actual = this->run(system, x);
+            auto expected = this->next(model, x);
+            if (!this->postcondition(x, actual, expected))
+                return false;
+        }
+        return true;
+    }
+};
+
+/* Start a stateful property, see %stateful_property, testing
+ * %_System against %_Model with commands of type %_Command
+ * returning %_Output.
+ */
+#define BEGIN_STATEFUL_PROPERTY_TYPE(_Name, _Model, _System, _Command,      \
+        _Output)                                                            \
+    BEGIN_PROPERTY_TYPE_(                                                   \
+        _Name,                                                              \
+        qcxx::stateful_property,                                            \
+        _Model,                                                             \
+        _System,                                                            \
+        _Command,                                                           \
+        _Output                                                             \
+    )
+
+#define PROPERTY_ALLOWED(...)                                               \
+    virtual bool                                                            \
+    allowed(                                                                \
+        __VA_ARGS__                                                         \
+    ) override
+
+#define PROPERTY_RUN(...)                                                   \
+    virtual typename property_type::output_type                             \
+    run(                                                                    \
+        __VA_ARGS__                                                         \
+    ) override
+
+#define PROPERTY_NEXT(...)                                                  \
+    virtual typename property_type::output_type                             \
+    next(                                                                   \
+        __VA_ARGS__                                                         \
+    ) override
+
+#define PROPERTY_POSTCONDITION(...)                                         \
+    virtual bool                                                            \
+    postcondition(                                                          \
+        __VA_ARGS__                                                         \
+    ) override
+
+class pct_scheduler;
+
+struct scheduler_slot_
+{
+    pct_scheduler* scheduler;
+    std::size_t thread;
+};
+
+inline scheduler_slot_&
+scheduler_slot_of_this_thread_(
+    void
+) {
+    static thread_local scheduler_slot_ slot = {nullptr, 0};
+    return slot;
+}
+
+/* A deterministic scheduler for the threads of a concurrent
+ * history, after the probabilistic concurrency testing of
+ * Burckhardt et al. Only one thread runs at a time, the one
+ * with the highest priority among those not waiting, until it
+ * reaches a %yield_point(). Every yield point is a step, and
+ * at the steps of the schedule's preemptions the running
+ * thread drops below every other thread, the later
+ * preemptions lower, in whatever order they are given. The
+ * interleaving is then a function of the schedule alone, and
+ * finds bugs needing d - 1 preemptions with a probability of
+ * at least 1 / (n k^(d-1)) for n threads and k steps.
+ */
+class pct_scheduler
+{
+public:
+    
+    explicit
+    pct_scheduler(
+        const pct_schedule& schedule,
+        const std::size_t& n_threads
+    ) :
+        mutex_(),
+        cond_(),
+        priority_(n_threads, 0),
+        state_(n_threads, RUNNABLE_),
+        preemptions_(schedule.preemptions),
+        n_entered_(0),
+        n_preempted_(0),
+        steps_(0),
+        running_(n_threads)
+    {
+        std::sort(this->preemptions_.begin(), this->preemptions_.end());
+        
+        const auto top = preemptions_.size() + n_threads;
+        std::size_t rank = 0;
+        for (auto t : schedule.priorities)
+            if (t < n_threads && !priority_[t])
+                priority_[t] = top - rank++;
+        for (std::size_t t = 0; t < n_threads; ++t)
+            if (!priority_[t])
+                priority_[t] = top - rank++;
+    }
+    
+    pct_scheduler(
+        const pct_scheduler&
+    ) = delete;
+    
+    pct_scheduler&
+    operator=(
+        const pct_scheduler&
+    ) = delete;
+    
+    /* Start running the calling thread as thread %t, once all
+     * threads have entered and it is its turn.
+     */
+    void
+    enter(
+        const std::size_t& t
+    ) {
+        scheduler_slot_of_this_thread_() = {this, t};
+        
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        if (++this->n_entered_ == this->state_.size())
+            this->pick_();
+        this->wait_(lock, t);
+    }
+    
+    /* Let another thread run at the current step. A %waiting
+     * thread, spinning on a lock, is not picked again until
+     * another thread has made progress.
+     */
+    void
+    yield(
+        const bool& waiting
+    ) {
+        const auto t = scheduler_slot_of_this_thread_().thread;
+        
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        ++this->steps_;
+        while (
+            this->n_preempted_ < this->preemptions_.size() &&
+            this->preemptions_[this->n_preempted_] <= this->steps_
+        )
+            this->priority_[t] =
+                this->preemptions_.size() - this->n_preempted_++;
+        
+        if (!waiting)
+            this->wake_();
+        this->state_[t] = waiting? WAITING_: RUNNABLE_;
+        this->pick_();
+        this->wait_(lock, t);
+    }
+    
+    /* Stop running the calling thread, letting the others run.
+     */
+    void
+    leave(
+        void
+    ) {
+        const auto t = scheduler_slot_of_this_thread_().thread;
+        scheduler_slot_of_this_thread_() = {nullptr, 0};
+        
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->wake_();
+        this->state_[t] = DONE_;
+        this->pick_();
+    }
+    
+private:
+    enum state_type_
+    {
+        RUNNABLE_,
+        WAITING_,
+        DONE_
+    };
+    
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<std::size_t> priority_;
+    std::vector<state_type_> state_;
+    std::vector<std::uint64_t> preemptions_;
+    std::size_t n_entered_;
+    std::size_t n_preempted_;
+    std::uint64_t steps_;
+    std::size_t running_;
+    
+    void
+    wake_(
+        void
+    ) {
+        for (auto& s : this->state_)
+            if (s == WAITING_)
+                s = RUNNABLE_;
+    }
+    
+    /* Run the runnable thread with the highest priority, or the
+     * waiting one if all are waiting, so that a deadlock spins
+     * until the test times out.
+     */
+    void
+    pick_(
+        void
+    ) {
+        const auto n = this->state_.size();
+        auto best = n;
+        for (auto s : {RUNNABLE_, WAITING_}) {
+            for (std::size_t t = 0; t < n; ++t)
+                if (
+                    this->state_[t] == s && (
+                        best == n ||
+                        this->priority_[t] > this->priority_[best]
+                    )
+                )
+                    best = t;
+            if (best < n)
+                break;
+        }
+        this->running_ = best;
+        this->cond_.notify_all();
+    }
+    
+    void
+    wait_(
+        std::unique_lock<std::mutex>& lock,
+        const std::size_t& t
+    ) {
+        this->cond_.wait(lock, [this, t] {
+            return this->running_ == t;
+        });
+    }
+};
+
+/* A point where %pct_scheduler may switch threads, to be called
+ * by concurrent systems between their accesses to shared
+ * state, with %waiting set when spinning on a lock. On threads
+ * not run by a scheduler, it only yields if %waiting.
+ */
+inline void
+yield_point(
+    const bool& waiting = false
+) {
+    auto scheduler = scheduler_slot_of_this_thread_().scheduler;
+    if (scheduler)
+        scheduler->yield(waiting);
+    else if (waiting)
+        std::this_thread::yield();
+}
+
+/* An atomic reaching a %yield_point() before every operation,
+ * so that %pct_scheduler interleaves the threads at every
+ * access.
+ */
+template
+<
+    typename Type
+>
+class yielding_atomic
+{
+public:
+    
+    yielding_atomic(
+        void
+    ) :
+        x_()
+    {}
+    
+    yielding_atomic(
+        const Type& x
+    ) :
+        x_(x)
+    {}
+    
+    yielding_atomic(
+        const yielding_atomic&
+    ) = delete;
+    
+    yielding_atomic&
+    operator=(
+        const yielding_atomic&
+    ) = delete;
+    
+    Type
+    load(
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) const {
+        yield_point();
+        return this->x_.load(order);
+    }
+    
+    void
+    store(
+        const Type& x,
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) {
+        yield_point();
+        this->x_.store(x, order);
+    }
+    
+    Type
+    exchange(
+        const Type& x,
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) {
+        yield_point();
+        return this->x_.exchange(x, order);
+    }
+    
+    bool
+    compare_exchange_weak(
+        Type& expected,
+        const Type& desired,
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) {
+        yield_point();
+        return this->x_.compare_exchange_weak(expected, desired, order);
+    }
+    
+    bool
+    compare_exchange_strong(
+        Type& expected,
+        const Type& desired,
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) {
+        yield_point();
+        return this->x_.compare_exchange_strong(expected, desired, order);
+    }
+    
+    Type
+    fetch_add(
+        const Type& x,
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) {
+        yield_point();
+        return this->x_.fetch_add(x, order);
+    }
+    
+    Type
+    fetch_sub(
+        const Type& x,
+        const std::memory_order& order = std::memory_order_seq_cst
+    ) {
+        yield_point();
+        return this->x_.fetch_sub(x, order);
+    }
+    
+    operator Type(
+        void
+    ) const {
+        return this->load();
+    }
+    
+    Type
+    operator=(
+        const Type& x
+    ) {
+        this->store(x);
+        return x;
+    }
+    
+private:
+    std::atomic<Type> x_;
+};
+
+/* A mutex reaching a %yield_point() before locking and after
+ * unlocking, spinning on its lock so that %pct_scheduler
+ * decides which thread gets it.
+ */
+class yielding_mutex
+{
+public:
+    
+    yielding_mutex(
+        void
+    ) :
+        mutex_()
+    {}
+    
+    yielding_mutex(
+        const yielding_mutex&
+    ) = delete;
+    
+    yielding_mutex&
+    operator=(
+        const yielding_mutex&
+    ) = delete;
+    
+    void
+    lock(
+        void
+    ) {
+        yield_point();
+        while (!this->mutex_.try_lock())
+            yield_point(true);
+    }
+    
+    bool
+    try_lock(
+        void
+    ) {
+        yield_point();
+        return this->mutex_.try_lock();
+    }
+    
+    void
+    unlock(
+        void
+    ) {
+        this->mutex_.unlock();
+        yield_point();
+    }
+    
+private:
+    std::mutex mutex_;
+};
+
+/* A command run by one thread of a concurrent history, with
+ * its output and the times it was invoked and returned at, on
+ * a clock shared by the threads.
+ */
+template
+<
+    typename Command,
+    typename Output
+>
+struct operation
+{
+    Command command;
+    Output output;
+    std::uint64_t invoke;
+    std::uint64_t response;
+};
+
+template
+<
+    typename Model,
+    typename Command,
+    typename Output,
+    typename Next,
+    typename Equivalent
+>
+bool
+linearize_(
+    const Model& model,
+    const std::vector<operation<Command, Output>>& history,
+    const std::uint64_t& done,
+    Next& next,
+    Equivalent& equivalent,
+    std::set<std::pair<std::uint64_t, Model>>& seen
+) {
+    const auto n = history.size();
+    if (done == (n < 64? (std::uint64_t(1) << n) - 1: ~std::uint64_t(0)))
+        return true;
+    if (!seen.emplace(done, model).second)
+        return false;
+    
+    auto first = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t i = 0; i < n; ++i)
+        if (!(done >> i & 1))
+            first = std::min(first, history[i].response);
+    
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& op = history[i];
+        if (done >> i & 1 || op.invoke > first)
+            continue;
+        
+        Model m = model;
+        auto expected = next(m, op.command);
+        if (
+            equivalent(op.command, op.output, expected) &&
+            linearize_(m, history, done | std::uint64_t(1) << i,
+                next, equivalent, seen)
+        )
+            return true;
+    }
+    return false;
+}
+
+/* Whether %history is linearizable with respect to the
+ * sequential %model: whether its operations can be ordered,
+ * consistently with the times they were invoked and returned
+ * at, so that applying them in order to the model with %next
+ * gives outputs %equivalent to theirs. This is the search of
+ * Wing and Gong, remembering the states reached for every set
+ * of linearized operations as suggested by Lowe, so that
+ * %Model must be copyable and ordered by <. Histories have at
+ * most 64 operations.
+ */
+template
+<
+    typename Model,
+    typename Command,
+    typename Output,
+    typename Next,
+    typename Equivalent
+>
+bool
+linearizable(
+    const Model& model,
+    const std::vector<operation<Command, Output>>& history,
+    Next next,
+    Equivalent equivalent
+) {
+    if (history.size() > 64)
+        QCXX_THROW(std::length_error,
+            "qcxx::linearizable: more than 64 operations");
+    
+    std::set<std::pair<std::uint64_t, Model>> seen;
+    return linearize_(model, history, 0, next, equivalent, seen);
+}
+
+/* Base class for linearizability tests of concurrent systems,
+ * like lock-free queues and maps. Every test runs generated
+ * sequences of commands, one per thread, concurrently against
+ * a new %System with %run(), recording when each command was
+ * invoked and returned, and checks that the history is
+ * %linearizable with respect to a new %Model, using %next()
+ * and %postcondition() as in %stateful_property. Every history
+ * is run %parallel_config::n_runs times. The threads are
+ * started together, on a yielding barrier, so that their
+ * commands overlap, or run one at a time by %pct_scheduler if
+ * %parallel_config::scheduled is set. Commands must be valid
+ * in every state, %run() being called concurrently.
+ */
+template
+<
+    typename Engine,
+    typename Model,
+    typename System,
+    typename Command,
+    typename Output
+>
+class concurrent_property :
+    public property<
+        Engine,
+        parallel_commands<Command>
+    >
+{
+public:
+    typedef property<
+        Engine,
+        parallel_commands<Command>
+    > property_type;
+    typedef Model model_type;
+    typedef System system_type;
+    typedef Command command_type;
+    typedef Output output_type;
+    typedef operation<
+        Command,
+        Output
+    > operation_type;
+    
+    explicit
+    concurrent_property(
+        Engine& engine,
+        qc_config& conf,
+        const parallel_config& parallel = parallel_settings()
+    ) :
+        property_type(engine, conf),
+        parallel_(parallel)
+    {}
+    
+    virtual Output
+    run(
+        System& system,
+        const Command& command
+    ) = 0;
+    
+    virtual Output
+    next(
+        Model& model,
+        const Command& command
+    ) = 0;
+    
+    virtual bool
+    postcondition(
+        const Command&,
+        const Output& actual,
+        const Output& expected
+    ) {
+        return actual == expected;
+    }
+    
+    virtual result
+    test(
+        parallel_commands<Command> xs
+    ) {
+        const auto n_runs = xs.schedule.empty()? this->parallel_.n_runs: 1;
+        for (size_type k = 0; k < n_runs; ++k)
+            if (!this->linearizable_(this->history(xs)))
+                return false;
+        return true;
+    }
+    
+    /* Run %xs once, concurrently, returning the history of the
+     * run. If %xs has a schedule, the threads are run by
+     * %pct_scheduler, switching at every %yield_point() and
+     * before every command, so that the history only depends on
+     * %xs.
+     */
+    std::vector<operation_type>
+    history(
+        const parallel_commands<Command>& xs
+    ) {
+        const auto n = xs.size();
+        const auto scheduled = !xs.schedule.empty();
+        System system;
+        pct_scheduler scheduler(xs.schedule, n);
+        std::atomic<std::uint64_t> clock(0);
+        std::atomic<std::size_t> ready(0);
+        std::vector<std::vector<operation_type>> ops(n);
+        std::vector<std::exception_ptr> errors(n);
+        
+        auto work = [&](const std::size_t& t) {
+            ops[t].reserve(xs[t].size());
+            if (scheduled) {
+                scheduler.enter(t);
+            } else {
+                ready++;
+                while (ready.load() < n)
+                    std::this_thread::yield();
+            }
+            try {
+                for (const auto& x : xs[t]) {
+                    if (scheduled)
+                        yield_point();
+                    auto invoke = clock++;
+                    auto output = this->run(system, x);
+                    auto response = clock++;
+                    ops[t].push_back(operation_type{
+                        x, std::move(output), invoke, response
+                    });
+                }
+            } catch(...) {
+                errors[t] = std::current_exception();
+            }
+            if (scheduled)
+                scheduler.leave();
+        };
+        
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1; t < n; ++t)
+            threads.emplace_back(work, t);
+        if (n)
+            work(0);
+        for (auto& thread : threads)
+            thread.join();
+        
+        std::vector<operation_type> history;
+        for (std::size_t t = 0; t < n; ++t) {
+            if (errors[t])
+                std::rethrow_exception(errors[t]);
+            history.insert(history.end(), ops[t].begin(), ops[t].end());
+        }
+        return history;
+    }
+    
+private:
+    parallel_config parallel_;
+    
+    bool
+    linearizable_(
+        const std::vector<operation_type>& history
+    ) {
+        return linearizable(
+            Model(),
+            history,
+            [this](Model& m, const Command& c) {
+                return this->next(m, c);
+            },
+            [this](const Command& c, const Output& a, const Output& b) {
+                return this->postcondition(c, a, b);
+            }
+        );
+    }
+};
+
+/* Start a concurrent property, see %concurrent_property,
+ * testing %_System against %_Model with commands of type
+ * %_Command returning %_Output.
+ */
+#define BEGIN_CONCURRENT_PROPERTY_TYPE(_Name, _Model, _System, _Command,    \
+        _Output)                                                            \
+    BEGIN_PROPERTY_TYPE_(                                                   \
+        _Name,                                                              \
+        qcxx::concurrent_property,                                          \
+        _Model,                                                             \
+        _System,                                                            \
+        _Command,                                                           \
+        _Output                                                             \
+    )
+
+/**
+ * %enumerable_()
+ * @{
+ */
+template
+<
+    bool...
+>
+struct bool_pack_
+{};
+
+template
+<
+    typename... Params
+>
+constexpr bool
+enumerable_(
+    std::tuple<Params...>*
+) {
+    return std::is_same<
+        bool_pack_<true, is_enumerable<Params>::value...>,
+        bool_pack_<is_enumerable<Params>::value..., true>
+    >::value;
+}
+/**
+ * @}
+ */
+
+/* The number of values %check_exhaustive_() would test, or
+ * the maximum value of %std::size_t if there are too many, the
+ * parameters are not enumerable, or the enumeration would not
+ * be %complete although it is required to be.
+ */
+/**
+ * %enumeration_size_()
+ * @{
+ */
+template
+<
+    typename... Params
+>
+typename std::enable_if<
+    enumerable_(static_cast<std::tuple<Params...>*>(nullptr)),
+    std::size_t
+>::type
+enumeration_size_(
+    const size_type& depth,
+    const bool& complete,
+    std::tuple<Params...>*
+) {
+    product_enumerator<Params...> space(depth);
+    
+    return !complete || space.complete()?
+        space.size():
+        std::numeric_limits<std::size_t>::max();
+}
+template
+<
+    typename... Params
+>
+typename std::enable_if<
+    !enumerable_(static_cast<std::tuple<Params...>*>(nullptr)),
+    std::size_t
+>::type
+enumeration_size_(
+    const size_type&,
+    const bool&,
+    std::tuple<Params...>*
+) {
+    return std::numeric_limits<std::size_t>::max();
+}
+/**
+ * @}
+ */
+
+template
+<
+    typename Property,
+    typename Tuple,
+    std::size_t... I
+>
+result
+check_tuple_(
+    Property& prop,
+    const Tuple& xs,
+    std::index_sequence<I...>
+) {
+    return prop.check(std::get<I>(xs)...);
+}
+
+template
+<
+    typename Property,
+    typename Tuple,
+    std::size_t... I
+>
+result
+step_tuple_(
+    Property& prop,
+    const Tuple& xs,
+    std::index_sequence<I...>
+) {
+    return prop.step(
+        std::list<typename std::tuple_element<I, Tuple>::type>(
+            1, std::get<I>(xs)
+        )...
+    );
+}
+
+/**
+ * %check_exhaustive_()
+ * @{
+ */
+/* Test %Property with every value of its parameters, up to the
+ * configured depth. The values are split into chunks which are
+ * handed out to the threads, every thread using a property and
+ * engine of its own. Values are enumerated smallest first and
+ * the smallest failing one is reported, so no shrinking is
+ * needed.
+ */
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine,
+    typename... Params
+>
+typename std::enable_if<
+    enumerable_(static_cast<std::tuple<Params...>*>(nullptr)),
+    result
+>::type
+check_exhaustive_(
+    qc_config& conf,
+    reporter& rep,
+    std::tuple<Params...>*
+) {
+    typedef RandomEngine engine_type;
+    typedef std::chrono::steady_clock clock_type;
+    
+    typedef Property<
+        engine_type
+    > property_type;
+    
+    const std::size_t chunk = 64;
+    const auto start = clock_type::now();
+    const product_enumerator<Params...> space(conf.depth);
+    const auto n = space.size();
+    
+    std::size_t n_threads = conf.n_threads?
+        conf.n_threads: std::thread::hardware_concurrency();
+    n_threads = std::max<std::size_t>(1, std::min<std::size_t>(
+        n_threads, n / chunk + (n % chunk != 0)));
+    
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> first_failure(n);
+    std::vector<qc_config> confs(n_threads, conf);
+    
+    auto work = [&](const std::size_t& t) {
+        auto& local = confs[t];
+        local.n_tests = 0;
+        local.n_discards = 0;
+        local.n_rejects = 0;
+        local.discard_sites.clear();
+        local.labels.clear();
+        
+        engine_type engine(
+            static_cast<typename engine_type::result_type>(conf.seed + t)
+        );
+        property_type prop(engine, local);
+        prop.setup();
+        
+        for (;;) {
+            auto i = next.fetch_add(chunk);
+            if (i >= n || i >= first_failure.load())
+                break;
+            for (auto j = i; j < i + std::min(chunk, n - i); ++j) {
+                result r;
+                try {
+                    r = check_tuple_(
+                        prop,
+                        space[j],
+                        std::index_sequence_for<Params...>()
+                    );
+                    if (r == TEST_DISCARD)
+                        local.discard_sites[r.where()? r.where(): "test"]++;
+                } catch(const discarded& e) {
+                    local.discard_sites[e.what()]++;
+                    r = TEST_DISCARD;
+                } catch(...) {
+                    r = TEST_FAILURE;
+                }
+                
+                if (r == TEST_FAILURE) {
+                    auto k = first_failure.load();
+                    while (j < k && !first_failure.compare_exchange_weak(k, j))
+                        ;
+                    break;
+                } else if (r == TEST_DISCARD) {
+                    local.n_discards++;
+                } else
+                    local.n_tests++;
+            }
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < n_threads; ++t)
+        threads.emplace_back(work, t);
+    work(0);
+    for (auto& thread : threads)
+        thread.join();
+    
+    conf.n_tests = 0;
+    conf.n_discards = 0;
+    conf.n_rejects = 0;
+    conf.discard_sites.clear();
+    conf.labels.clear();
+    for (const auto& local : confs) {
+        conf.n_tests += local.n_tests;
+        conf.n_discards += local.n_discards;
+        for (const auto& site : local.discard_sites)
+            conf.discard_sites[site.first] += site.second;
+        for (const auto& label : local.labels)
+            conf.labels[label.first] += label.second;
+        for (const auto& c : local.coverage)
+            conf.coverage[c.first] = c.second;
+    }
+    
+    engine_type engine(
+        static_cast<typename engine_type::result_type>(conf.seed)
+    );
+    property_type prop(engine, conf);
+    
+    prop.open_report();
+    prop.last_report().exhaustive = true;
+    
+    result r = conf.n_tests? TEST_SUCCESS: TEST_DISCARD;
+    
+    auto i = first_failure.load();
+    if (i < n) {
+        /* Values before the failing one may have been tested by
+         * threads which were still running, only count them.
+         */
+        conf.n_tests = std::min<size_type>(
+            conf.n_tests,
+            static_cast<size_type>(i)
+        );
+        
+        try {
+            step_tuple_(
+                prop,
+                space[i],
+                std::index_sequence_for<Params...>()
+            );
+        } catch(const std::exception& e) {
+            prop.last_report().message = std::string(
+                "caught exception: ") + e.what();
+        } catch(...) {
+            prop.last_report().message = "caught exception";
+        }
+        r = TEST_FAILURE;
+    }
+    
+    return prop.close_report(
+        rep,
+        r,
+        std::chrono::duration_cast<
+            std::chrono::nanoseconds
+        >(clock_type::now() - start)
+    );
+}
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine,
+    typename... Params
+>
+typename std::enable_if<
+    !enumerable_(static_cast<std::tuple<Params...>*>(nullptr)),
+    result
+>::type
+check_exhaustive_(
+    qc_config&,
+    reporter&,
+    std::tuple<Params...>*
+) {
+    QCXX_THROW(
+        std::logic_error,
+        "qcxx::check_exhaustive_: ENUMERATE_ALWAYS but the parameters "
+            "are not enumerable"
+    );
+}
+/**
+ * @}
+ */
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937,
+    typename RandomDevice = std::random_device
+>
+result
+quickCheckWith(
+    qc_config& conf,
+    reporter& rep
+) {
+    typedef RandomEngine engine_type;
+    typedef RandomDevice device_type;
+    
+    typedef Property<
+        engine_type
+    > property_type;
+    
+    if (!conf.fixed_seed) {
+        device_type device;
+        conf.seed = device();
+    }
+    
+    typename property_type::params_type* params = nullptr;
+    
+    auto exhaustive = conf.enumerate == ENUMERATE_ALWAYS;
+    if (conf.enumerate == ENUMERATE_AUTO) {
+        auto n = enumeration_size_(conf.depth, true, params);
+        exhaustive = (
+            n < std::numeric_limits<std::size_t>::max() &&
+            n <= conf.max_enumerated
+        );
+    }
+    if (exhaustive) {
+        return check_exhaustive_<
+            Property,
+            RandomEngine
+        >(conf, rep, params);
+    }
+    
+    engine_type engine(
+        static_cast<typename engine_type::result_type>(conf.seed)
+    );
+    
+    property_type prop(engine, conf);
+    
+    return prop.go(rep);
+}
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937,
+    typename RandomDevice = std::random_device
+>
+result
+quickCheckWith(
+    qc_config& conf,
+    std::ostream& out
+) {
+    text_reporter rep(out);
+    
+    return quickCheckWith<
+        Property,
+        RandomEngine,
+        RandomDevice
+    >(conf, rep);
+}
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937,
+    typename RandomDevice = std::random_device
+>
+result
+quickCheck(
+    void
+) {
+    qc_config conf = qc_settings();
+    
+    return quickCheckWith<
+        Property,
+        RandomEngine,
+        RandomDevice
+    >(conf, std::cout);
+}
+
+/* Settings for %benchmarkWith(). For every size, %n_inputs
+ * values are generated with %property::workload() from an
+ * engine seeded with %seed, then tested %n_rounds times,
+ * after one untimed round.
+ */
+struct bench_config
+{
+    bench_config(
+        void
+    ) :
+        seed(0),
+        sizes({1, 10, 100, 1000}),
+        n_inputs(64),
+        n_rounds(16)
+    {}
+    
+    seed_type seed;
+    std::vector<std::size_t> sizes;
+    size_type n_inputs;
+    size_type n_rounds;
+};
+
+/* The time per test of a property for one size, over the
+ * rounds of a benchmark, in nanoseconds, and the operations
+ * per test it counted with %property::tally(), if any.
+ */
+struct bench_point
+{
+    bench_point(
+        void
+    ) :
+        size(0),
+        mean(0),
+        median(0),
+        variance(0),
+        ops(0),
+        n_failures(0)
+    {}
+    
+    std::size_t size;
+    double mean;
+    double median;
+    double variance;
+    double ops;
+    size_type n_failures;
+};
+
+template
+<
+    typename Property,
+    std::size_t... I
+>
+result
+bench_test_(
+    Property& prop,
+    typename Property::params_type& xs,
+    std::index_sequence<I...>
+) {
+    if (!alloc_tracker_installed())
+        return prop.test(std::move(std::get<I>(xs))...);
+    
+    alloc_scope scope;
+    return prop.test(std::move(std::get<I>(xs))...);
+}
+
+/* Run the test of %Property as a benchmark, for every size of
+ * the sweep, reporting the time per test, its variance and
+ * the throughput as metrics. The values are generated, and
+ * copied for every round, outside of the timed region, and
+ * moved into %test(). Every call is timed on its own, after
+ * the fixture has been reset. Tests should pass; failures in
+ * the timed rounds are counted and make the report fail, but
+ * are not shrunk.
+ */
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937
+>
+std::vector<bench_point>
+benchmarkWith(
+    const bench_config& conf,
+    reporter& rep
+) {
+    typedef std::chrono::steady_clock clock_type;
+    typedef RandomEngine engine_type;
+    typedef Property<
+        engine_type
+    > property_type;
+    typedef typename property_type::params_type params_type;
+    
+    std::vector<bench_point> points;
+    
+    for (auto size : conf.sizes) {
+        qc_config qc;
+        qc.seed = conf.seed;
+        qc.fixed_seed = true;
+        
+        engine_type engine(
+            static_cast<typename engine_type::result_type>(conf.seed)
+        );
+        property_type prop(engine, qc);
+        
+        std::vector<params_type> inputs;
+        inputs.reserve(conf.n_inputs);
+        for (size_type i = 0; i < conf.n_inputs; ++i)
+            inputs.push_back(prop.workload(size));
+        prop.setup();
+        
+        bench_point point;
+        point.size = size;
+        
+        std::vector<double> rounds;
+        auto start = clock_type::now();
+        
+        for (size_type k = 0; k <= conf.n_rounds; ++k) {
+            auto xs = inputs;
+            
+            const auto ops = prop.tallied();
+            clock_type::duration elapsed(0);
+            for (auto& x : xs) {
+                prop.reset();
+                auto t0 = clock_type::now();
+                auto r = bench_test_(prop, x, std::make_index_sequence<
+                    std::tuple_size<params_type>::value>());
+                elapsed += clock_type::now() - t0;
+                if (k && r == TEST_FAILURE)
+                    point.n_failures++;
+            }
+            
+            if (!k && !xs.empty())
+                point.ops = (prop.tallied() - ops) / xs.size();
+            if (k && !xs.empty()) {
+                rounds.push_back(
+                    static_cast<double>(
+                        std::chrono::duration_cast<
+                            std::chrono::nanoseconds
+                        >(elapsed).count()
+                    ) / xs.size()
+                );
+            }
+        }
+        
+        if (!rounds.empty()) {
+            point.mean = std::accumulate(
+                rounds.begin(), rounds.end(), 0.0) / rounds.size();
+            for (auto t : rounds)
+                point.variance += (t - point.mean) * (t - point.mean);
+            if (rounds.size() > 1)
+                point.variance /= rounds.size() - 1;
+            std::sort(rounds.begin(), rounds.end());
+            point.median = rounds.size() % 2?
+                rounds[rounds.size() / 2]:
+                (rounds[rounds.size() / 2 - 1] + rounds[rounds.size() / 2]) / 2;
+        }
+        
+        report r;
+        r.name = prop.name() + "/" + std::to_string(size);
+        r.status = point.n_failures? TEST_FAILURE: TEST_SUCCESS;
+        r.n_tests = conf.n_inputs * conf.n_rounds;
+        r.seed = conf.seed;
+        r.elapsed = std::chrono::duration_cast<
+            std::chrono::nanoseconds
+        >(clock_type::now() - start);
+        if (point.n_failures) {
+            r.message = std::to_string(point.n_failures) +
+                " tests failed while benchmarking";
+        }
+        r.metrics.emplace_back("size", size);
+        r.metrics.emplace_back("ns_per_op", point.mean);
+        r.metrics.emplace_back("ns_per_op_median", point.median);
+        r.metrics.emplace_back("ns_per_op_variance", point.variance);
+        r.metrics.emplace_back("ops_per_s", point.mean > 0?
+            1e9 / point.mean: std::numeric_limits<double>::infinity());
+        if (point.ops > 0)
+            r.metrics.emplace_back("tallied_per_op", point.ops);
+        rep(r);
+        
+        points.push_back(point);
+    }
+    
+    return points;
+}
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937
+>
+std::vector<bench_point>
+benchmarkWith(
+    const bench_config& conf,
+    std::ostream& out
+) {
+    text_reporter rep(out);
+    
+    return benchmarkWith<
+        Property,
+        RandomEngine
+    >(conf, rep);
+}
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937
+>
+std::vector<bench_point>
+benchmark(
+    void
+) {
+    bench_config conf;
+    
+    return benchmarkWith<
+        Property,
+        RandomEngine
+    >(conf, std::cout);
+}
+
+/* Settings for %checkComplexityWith(). The property is
+ * benchmarked for sizes from %min_size up to %max_size, each
+ * %growth times the previous one, using the median time per
+ * test over %n_rounds rounds of %n_inputs values. A fitted
+ * cost growing by less than %tolerance times the mean cost
+ * from the smallest size to the largest counts as constant.
+ */
+struct complexity_config
+{
+    complexity_config(
+        void
+    ) :
+        seed(0),
+        min_size(64),
+        max_size(4096),
+        growth(2),
+        n_inputs(8),
+        n_rounds(5),
+        tolerance(1)
+    {}
+    
+    seed_type seed;
+    std::size_t min_size;
+    std::size_t max_size;
+    std::size_t growth;
+    size_type n_inputs;
+    size_type n_rounds;
+    double tolerance;
+};
+
+/* Benchmark %Property for geometrically increasing sizes and
+ * fit the cost per test to every complexity class, as a
+ * constant plus the least squares multiple of its function,
+ * so that a fixed setup cost does not favour higher classes.
+ * The cost is the number of operations counted with
+ * %property::tally() if the property counts any, and the
+ * median time otherwise. The lowest class whose relative root
+ * mean square error is at most twice the smallest one is
+ * chosen, or O(1) if its fitted growth is within
+ * %complexity_config::tolerance, since a constant fits as
+ * every class with a zero multiple. Times are fitted without
+ * the size they fit worst, which a single disturbance, like
+ * the allocator returning memory to the system, may skew.
+ * The run fails if the class exceeds the one declared by the
+ * property with %EXPECT_COMPLEXITY, or if a test fails. Times
+ * are noisy, and classes are only told apart reliably by a
+ * wide enough range of sizes; O(log n) is hardly told apart
+ * from O(1) by times.
+ */
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937
+>
+result
+checkComplexityWith(
+    const complexity_config& conf,
+    reporter& rep
+) {
+    typedef Property<
+        RandomEngine
+    > property_type;
+    
+    bench_config bench;
+    bench.seed = conf.seed;
+    bench.n_inputs = conf.n_inputs;
+    bench.n_rounds = conf.n_rounds;
+    bench.sizes.clear();
+    for (auto n = std::max<std::size_t>(conf.min_size, 1);
+            n <= conf.max_size;
+            n *= std::max<std::size_t>(conf.growth, 2))
+        bench.sizes.push_back(n);
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    null_reporter none;
+    auto points = benchmarkWith<
+        Property,
+        RandomEngine
+    >(bench, none);
+    
+    qc_config qc;
+    RandomEngine engine;
+    property_type prop(engine, qc);
+    
+    report r;
+    r.name = prop.name();
+    r.seed = conf.seed;
+    
+    std::vector<std::pair<double, double>> errors;
+    auto tallied = !points.empty() && std::all_of(
+        points.begin(),
+        points.end(),
+        [](const bench_point& p) {
+            return p.ops > 0;
+        }
+    );
+    auto cost = [tallied](const bench_point& p) {
+        return tallied? p.ops: p.median;
+    };
+    double mean = 0;
+    size_type n_failures = 0;
+    
+    for (const auto& p : points) {
+        mean += cost(p) / points.size();
+        n_failures += p.n_failures;
+        r.n_tests += conf.n_inputs * conf.n_rounds;
+    }
+    
+    /* The root mean square error of the fit of class %k to the
+     * costs, leaving out the point %skip, and the growth of the
+     * fitted cost over the sizes, both relative to the mean
+     * cost.
+     */
+    auto fit = [&](const complexity& k, const std::size_t& skip) {
+        const auto n = points.size() - (skip < points.size());
+        double mc = 0;
+        double mf = 0;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (i != skip) {
+                mc += cost(points[i]) / n;
+                mf += complexity_value(k, points[i].size) / n;
+            }
+        }
+        double tf = 0;
+        double ff = 0;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (i != skip) {
+                auto f = complexity_value(k, points[i].size) - mf;
+                tf += (cost(points[i]) - mc) * f;
+                ff += f * f;
+            }
+        }
+        auto coefficient = ff > 0? std::max(tf / ff, 0.0): 0.0;
+        auto constant = mc - coefficient * mf;
+        
+        double e = 0;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (i != skip) {
+                auto d = cost(points[i]) - constant -
+                    coefficient * complexity_value(k, points[i].size);
+                e += d * d;
+            }
+        }
+        auto growth = coefficient * (
+            complexity_value(k, points.back().size) -
+            complexity_value(k, points.front().size)
+        );
+        return std::make_pair(std::sqrt(e / n) / mean, growth / mean);
+    };
+    
+    for (int c = COMPLEXITY_1; c < COMPLEXITY_ANY && mean > 0; ++c) {
+        auto k = static_cast<complexity>(c);
+        auto e = fit(k, points.size());
+        if (!tallied && points.size() > 3) {
+            for (std::size_t i = 0; i < points.size(); ++i)
+                e = std::min(e, fit(k, i));
+        }
+        
+        std::string name = std::string("rms_") + complexity_name(k);
+        std::replace(name.begin(), name.end(), ' ', '_');
+        r.metrics.emplace_back(name, e.first);
+        errors.push_back(e);
+    }
+    
+    auto fitted = COMPLEXITY_ANY;
+    if (!errors.empty()) {
+        auto best = std::min_element(errors.begin(), errors.end())->first;
+        auto k = std::find_if(
+            errors.begin(),
+            errors.end(),
+            [&](const std::pair<double, double>& e) {
+                return e.first <= 2 * best + 1e-9;
+            }
+        );
+        fitted = k->second < conf.tolerance?
+            COMPLEXITY_1:
+            static_cast<complexity>(k - errors.begin());
+    }
+    for (const auto& p : points) {
+        r.metrics.emplace_back(
+            "median_ns_" + std::to_string(p.size), p.median);
+        if (tallied) {
+            r.metrics.emplace_back(
+                "tallied_" + std::to_string(p.size), p.ops);
+        }
+    }
+    
+    auto expected = prop.expected_complexity();
+    
+    r.status = TEST_SUCCESS;
+    if (n_failures) {
+        r.status = TEST_FAILURE;
+        r.message = std::to_string(n_failures) +
+            " tests failed while benchmarking";
+    } else if (fitted > expected) {
+        r.status = TEST_FAILURE;
+        r.message = std::string("fitted O(") + complexity_name(fitted) +
+            "), expected O(" + complexity_name(expected) + ")";
+    }
+    r.elapsed = std::chrono::duration_cast<
+        std::chrono::nanoseconds
+    >(std::chrono::steady_clock::now() - start);
+    
+    rep(r);
+    
+    return r.status;
+}
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937
+>
+result
+checkComplexityWith(
+    const complexity_config& conf,
+    std::ostream& out
+) {
+    text_reporter rep(out);
+    
+    return checkComplexityWith<
+        Property,
+        RandomEngine
+    >(conf, rep);
+}
+
+template
+<
+    template
+    <
+        typename
+    >
+    class Property,
+    typename RandomEngine = std::mt19937
+>
+result
+checkComplexity(
+    void
+) {
+    complexity_config conf;
+    
+    return checkComplexityWith<
+        Property,
+        RandomEngine
+    >(conf, std::cout);
+}
+
+/* Get a random element.
+ */
+/**
+ * %oneof()
+ * @{
+ */
+template
+<
+    typename Engine,
+    typename Iterator
+>
+Iterator
+oneof(
+    Engine& engine,
+    Iterator begin,
+    Iterator end
+) {
+    auto gen = get_generator<typename std::iterator_traits<
+        Iterator
+    >::difference_type>(engine);
+    
+    std::advance(begin, gen(0, std::distance(begin, end) - 1));
+    
+    return begin;
+}
+template
+<
+    typename Engine,
+    typename Container
+>
+typename Container::iterator
+oneof(
+    Engine& engine,
+    Container& container
+) {
+    return oneof(engine, container.begin(), container.end());
+}
+/**
+ * @}
+ */
+
+/* Pick values according to integral weights in constant time
+ * using Vose's alias method. The table is built once, in linear
+ * time, from a container of (weight, value) pairs; every pick
+ * then costs two uniform draws. Picking is exact, a value with
+ * weight w is picked with probability w / sum(weights).
+ */
+template
+<
+    typename Type
+>
+class weighted_choice
+{
+public:
+    typedef Type value_type;
+    typedef unsigned long long weight_type;
+    
+    template
+    <
+        typename Container
+    >
+    explicit
+    weighted_choice(
+        const Container& xs
+    ) :
+        total_(0)
+    {
+        for (const auto& x : xs) {
+            this->values_.push_back(x.second);
+            this->total_ += static_cast<weight_type>(x.first);
+        }
+        if (this->total_ == 0) {
+            QCXX_THROW(
+                std::invalid_argument,
+                "qcxx::weighted_choice: the sum of all weights is zero"
+            );
+        }
+        
+        const auto n = this->values_.size();
+        
+        /* Scale all weights by n so that every bucket holds
+         * exactly %total_ and the table stays integral.
+         */
+        std::vector<weight_type> scaled;
+        std::vector<std::size_t> small;
+        std::vector<std::size_t> large;
+        
+        scaled.reserve(n);
+        for (const auto& x : xs)
+            scaled.push_back(static_cast<weight_type>(x.first) * n);
+        
+        for (std::size_t i = 0; i < n; ++i)
+            (scaled[i] < this->total_? small: large).push_back(i);
+        
+        this->threshold_.assign(n, this->total_);
+        this->alias_.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+            this->alias_[i] = i;
+        
+        while (!small.empty() && !large.empty()) {
+            auto s = small.back();
+            auto l = large.back();
+            small.pop_back();
+            large.pop_back();
+            
+            this->threshold_[s] = scaled[s];
+            this->alias_[s] = l;
+            
+            scaled[l] -= this->total_ - scaled[s];
+            (scaled[l] < this->total_? small: large).push_back(l);
+        }
+    }
+    
+    /* Pick a value using the given engine.
+     */
+    template
+    <
+        typename Engine
+    >
+    const Type&
+    operator()(
+        Engine& engine
+    ) const {
+        std::uniform_int_distribution<std::size_t> bucket(
+            0, this->values_.size() - 1
+        );
+        std::uniform_int_distribution<weight_type> coin(
+            0, this->total_ - 1
+        );
+        
+        auto i = bucket(engine);
+        
+        return coin(engine) < this->threshold_[i]?
+            this->values_[i]:
+            this->values_[this->alias_[i]];
+    }
+    
+    std::size_t
+    size(
+        void
+    ) const {
+        return this->values_.size();
+    }
+    
+    weight_type
+    total(
+        void
+    ) const {
+        return this->total_;
+    }
+    
+private:
+    std::vector<Type> values_;
+    std::vector<weight_type> threshold_;
+    std::vector<std::size_t> alias_;
+    weight_type total_;
+};
+
+/* Generate values using a %weighted_choice table.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class frequency_generator :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    frequency_generator(
+        Engine& engine,
+        const weighted_choice<Type>& choice
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        choice_(choice)
+    {}
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        return this->choice_(this->engine());
+    }
+    
+private:
+    weighted_choice<Type> choice_;
+};
+
+/* Get a random weighted value. This builds a new table on
+ * every call, use a %weighted_choice directly when picking
+ * repeatedly from the same values.
+ */
+template
+<
+    typename Engine,
+    typename Container
+>
+typename Container::value_type::second_type
+frequency(
+    Engine& engine,
+    const Container& xs
+) {
+    return weighted_choice<
+        typename Container::value_type::second_type
+    >(xs)(engine);
+}
+
+/* Generator combinators. Every combinator is a final generator
+ * holding its inner generators by value, so a composition is a
+ * single object whose calls can be inlined. Combinators also
+ * implement %sample(), shrinking through their inner generators
+ * where possible, and fall back to the minimizer of the result
+ * type where they can not.
+ */
+
+/* Advance %i unless it refers to the last element of %xs.
+ */
+template
+<
+    typename Iterator,
+    typename Container
+>
+void
+zip_advance_(
+    Iterator& i,
+    const Container& xs
+) {
+    if (std::next(i) != xs.end())
+        ++i;
+}
+
+/* Generate values using the %arbitrary generator of %Type and
+ * shrink them using its minimizer.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class arbitrary_generator final :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    arbitrary_generator(
+        Engine& engine
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        gen_(get_generator<Type>(engine))
+    {}
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        return this->gen_();
+    }
+    
+    std::list<Type>
+    sample(
+        void
+    ) {
+        return get_minimizer<Type>(this->engine())(this->gen_());
+    }
+    
+private:
+    typename arbitrary<
+        Type,
+        Engine
+    >::generator_type gen_;
+};
+
+template
+<
+    typename Type,
+    typename Engine
+>
+arbitrary_generator<
+    Type,
+    Engine
+>
+arbitrary_of(
+    Engine& engine
+) {
+    return arbitrary_generator<
+        Type,
+        Engine
+    >(engine);
+}
+
+/* Pick one of the given values, shrinking towards the first.
+ */
+template
+<
+    typename Type,
+    typename Engine
+>
+class elements_generator final :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    template
+    <
+        typename Container
+    >
+    explicit
+    elements_generator(
+        Engine& engine,
+        const Container& xs
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        xs_(xs.begin(), xs.end())
+    {
+        if (this->xs_.empty()) {
+            QCXX_THROW(
+                std::invalid_argument,
+                "qcxx::elements: no values to pick from"
+            );
+        }
+    }
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        return this->xs_[this->index()];
+    }
+    
+    std::list<Type>
+    sample(
+        void
+    ) {
+        std::list<Type> xs;
+        for (auto i = this->index(); i != 0; i /= 2)
+            xs.push_back(this->xs_[i]);
+        xs.push_back(this->xs_[0]);
+        return xs;
+    }
+    
+private:
+    std::size_t
+    index(
+        void
+    ) {
+        std::uniform_int_distribution<std::size_t> distribution(
+            0, this->xs_.size() - 1
         );
+        return distribution(this->engine());
     }
     
-    size_type n_tests;
-    size_type max_tests;
-    size_type n_discards;
-    size_type max_discards;
-    
+    std::vector<Type> xs_;
 };
 
-/* Base class for properties.
+/**
+ * %elements()
+ * @{
  */
 template
 <
     typename Engine,
-    typename... Params
+    typename Container
 >
-class property
+elements_generator<
+    typename Container::value_type,
+    Engine
+>
+elements(
+    Engine& engine,
+    const Container& xs
+) {
+    return elements_generator<
+        typename Container::value_type,
+        Engine
+    >(engine, xs);
+}
+template
+<
+    typename Engine,
+    typename Type
+>
+elements_generator<
+    Type,
+    Engine
+>
+elements(
+    Engine& engine,
+    std::initializer_list<Type> xs
+) {
+    return elements_generator<
+        Type,
+        Engine
+    >(engine, xs);
+}
+/**
+ * @}
+ */
+
+/* Apply %Function to generated values. Shrinking maps the
+ * shrunk values of the inner generator.
+ */
+template
+<
+    typename Function,
+    typename Generator
+>
+class map_generator final :
+    public generator<
+        typename std::decay<
+            typename std::result_of<
+                Function(typename Generator::value_type)
+            >::type
+        >::type,
+        typename Generator::engine_type
+    >
 {
 public:
-    typedef Engine engine_type;
+    typedef typename std::decay<
+        typename std::result_of<
+            Function(typename Generator::value_type)
+        >::type
+    >::type value_type;
+    typedef typename Generator::engine_type engine_type;
     
     explicit
-    property(
-        engine_type& engine,
-        qc_config& conf
+    map_generator(
+        Function f,
+        Generator gen
     ) :
-        engine_(engine),
-        conf_(conf)
+        generator<
+            value_type,
+            engine_type
+        >(gen.engine()),
+        f_(f),
+        gen_(gen)
     {}
     
-    virtual
-    ~property(
+    virtual value_type
+    operator()(
         void
     ) {
+        return this->f_(this->gen_());
     }
     
-    virtual result
-    test(
-        Params...
-    ) = 0;
+    std::list<value_type>
+    sample(
+        void
+    ) {
+        std::list<value_type> ys;
+        for (const auto& x : qcxx::sample(this->gen_))
+            ys.push_back(this->f_(x));
+        return ys;
+    }
     
-    virtual result
-    step(
-        std::ostream& out,
-        const std::list<Params>&... xs
+private:
+    Function f_;
+    Generator gen_;
+};
+
+template
+<
+    typename Function,
+    typename Generator
+>
+map_generator<
+    Function,
+    Generator
+>
+map(
+    Function f,
+    Generator gen
+) {
+    return map_generator<
+        Function,
+        Generator
+    >(f, gen);
+}
+
+/* Only generate values satisfying %Predicate, giving up after
+ * %max_tries attempts by throwing %discarded. Shrunk values
+ * not satisfying %Predicate are skipped.
+ */
+template
+<
+    typename Predicate,
+    typename Generator
+>
+class such_that_generator final :
+    public generator<
+        typename Generator::value_type,
+        typename Generator::engine_type
+    >
+{
+public:
+    typedef typename Generator::value_type value_type;
+    typedef typename Generator::engine_type engine_type;
+    
+    explicit
+    such_that_generator(
+        Predicate p,
+        Generator gen,
+        const size_type& max_tries
+    ) :
+        generator<
+            value_type,
+            engine_type
+        >(gen.engine()),
+        p_(p),
+        gen_(gen),
+        max_tries_(max_tries)
+    {}
+    
+    virtual value_type
+    operator()(
+        void
     ) {
-        auto r0 = this->test(this->data(xs)...);
-        auto wr = false;
-        
-        if (r0 == TEST_FAILURE) {
-            if (this->reducible(xs...)) {
-                auto r1 = this->step(
-                    out,
-                    this->reduce(xs)...
-                );
-                wr = (
-                    TEST_SUCCESS == r1 ||
-                    TEST_DISCARD == r1 ||
-                    TEST_NOTHING == r1
-                );
-            } else
-                wr = true;
+        for (size_type i = 0; i < this->max_tries_; ++i) {
+            auto x = this->gen_();
+            if (this->p_(x))
+                return x;
         }
-        if (wr)
-            this->failure(out, this->data(xs)...);
-        
-        return r0;
+        throw discarded("qcxx::such_that: precondition not satisfied");
     }
     
-    virtual result
-    go(
-        std::ostream& out
+    std::list<value_type>
+    sample(
+        void
     ) {
-        result r;
-        
-        while (this->config().again() && r != TEST_FAILURE) {
-            try {
-                r = this->step(
-                    out,
-                    get_minimizer<Params>(this->engine())(
-                        get_generator<Params>(
-                            this->engine()
-                        )()
-                    )...
-                );
-            } catch(...) {
-                out << "Failed, caught exception after "
-                    << this->config().n_tests + 1
-                    << " tests"
-                    << std::endl;
-                
-                r = TEST_FAILURE;
-            }
-            
-            switch (r) {
-            case TEST_SUCCESS:
-                this->config().n_tests++;
-                break;
-            case TEST_DISCARD:
-                this->config().n_discards++;
-                break;
-            default:
-                break;
+        for (size_type i = 0; i < this->max_tries_; ++i) {
+            auto xs = qcxx::sample(this->gen_);
+            if (this->p_(xs.front())) {
+                for (auto j = xs.begin(); j != xs.end(); ) {
+                    if (this->p_(*j))
+                        ++j;
+                    else
+                        j = xs.erase(j);
+                }
+                return xs;
             }
         }
-        
-        if (r == TEST_SUCCESS) {
-            out << "OK, "
-                << this->config().n_tests
-                << " tests passed, "
-                << this->config().n_discards
-                << " tests discarded"
-                << std::endl;
-        }
-        
-        return r;
+        throw discarded("qcxx::such_that: precondition not satisfied");
     }
     
-    virtual void
-    failure(
-        std::ostream& out,
-        Params... xs
+private:
+    Predicate p_;
+    Generator gen_;
+    size_type max_tries_;
+};
+
+template
+<
+    typename Predicate,
+    typename Generator
+>
+such_that_generator<
+    Predicate,
+    Generator
+>
+such_that(
+    Predicate p,
+    Generator gen,
+    const size_type& max_tries = 100
+) {
+    return such_that_generator<
+        Predicate,
+        Generator
+    >(p, gen, max_tries);
+}
+
+/* Generate a value, then generate the final value using the
+ * generator %Function returns for it. Only the final value is
+ * shrunk.
+ */
+template
+<
+    typename Function,
+    typename Generator
+>
+class bind_generator final :
+    public generator<
+        typename std::result_of<
+            Function(typename Generator::value_type)
+        >::type::value_type,
+        typename Generator::engine_type
+    >
+{
+public:
+    typedef typename std::result_of<
+        Function(typename Generator::value_type)
+    >::type generator_type;
+    typedef typename generator_type::value_type value_type;
+    typedef typename Generator::engine_type engine_type;
+    
+    explicit
+    bind_generator(
+        Generator gen,
+        Function f
+    ) :
+        generator<
+            value_type,
+            engine_type
+        >(gen.engine()),
+        gen_(gen),
+        f_(f)
+    {}
+    
+    virtual value_type
+    operator()(
+        void
     ) {
-        out << "Falsifiable, after "
-            << this->config().n_tests + 1
-            << " tests: "
-            << std::endl;
-        
-        show_all(out, xs...);
+        auto gen = this->f_(this->gen_());
+        return gen();
     }
     
-    engine_type&
-    engine(
+    std::list<value_type>
+    sample(
         void
     ) {
-        return this->engine_;
+        auto gen = this->f_(this->gen_());
+        return qcxx::sample(gen);
     }
     
-    qc_config&
-    config(
+private:
+    Generator gen_;
+    Function f_;
+};
+
+template
+<
+    typename Generator,
+    typename Function
+>
+bind_generator<
+    Function,
+    Generator
+>
+bind(
+    Generator gen,
+    Function f
+) {
+    return bind_generator<
+        Function,
+        Generator
+    >(gen, f);
+}
+
+/* Generate tuples, one element per generator. All elements are
+ * shrunk at the same time, like the parameters of a property.
+ */
+template
+<
+    typename Generator,
+    typename... Generators
+>
+class tuple_generator final :
+    public generator<
+        std::tuple<
+            typename Generator::value_type,
+            typename Generators::value_type...
+        >,
+        typename Generator::engine_type
+    >
+{
+public:
+    typedef std::tuple<
+        typename Generator::value_type,
+        typename Generators::value_type...
+    > value_type;
+    typedef typename Generator::engine_type engine_type;
+    
+    explicit
+    tuple_generator(
+        Generator gen,
+        Generators... gens
+    ) :
+        generator<
+            value_type,
+            engine_type
+        >(gen.engine()),
+        gens_(gen, gens...)
+    {}
+    
+    virtual value_type
+    operator()(
         void
     ) {
-        return this->conf_;
+        return this->generate_(
+            std::index_sequence_for<Generator, Generators...>()
+        );
     }
     
-private:
-    engine_type& engine_;
-    qc_config& conf_;
+    std::list<value_type>
+    sample(
+        void
+    ) {
+        return this->sample_(
+            std::index_sequence_for<Generator, Generators...>()
+        );
+    }
     
-protected:
+private:
     template
     <
-        typename Container
+        std::size_t... I
     >
-    typename Container::value_type
-    data(
-        const Container& c
+    value_type
+    generate_(
+        std::index_sequence<I...>
     ) {
-        return *c.begin();
+        return value_type{
+            std::get<I>(this->gens_)()...
+        };
     }
     
     template
     <
-        typename Container
+        std::size_t... I
     >
-    Container
-    reduce(
-        const Container& c
+    std::list<value_type>
+    sample_(
+        std::index_sequence<I...>
+    ) {
+        std::tuple<
+            std::list<typename Generator::value_type>,
+            std::list<typename Generators::value_type>...
+        > xs{
+            qcxx::sample(std::get<I>(this->gens_))...
+        };
+        
+        std::size_t n = 0;
+        for (auto m : {std::get<I>(xs).size()...})
+            n = std::max(n, m);
+        
+        auto is = std::make_tuple(std::get<I>(xs).cbegin()...);
+        
+        std::list<value_type> ys;
+        for (std::size_t k = 0; k < n; ++k) {
+            ys.push_back(value_type(*std::get<I>(is)...));
+            (void)std::initializer_list<int>{
+                (zip_advance_(std::get<I>(is), std::get<I>(xs)), 0)...
+            };
+        }
+        return ys;
+    }
+    
+    std::tuple<
+        Generator,
+        Generators...
+    > gens_;
+};
+
+template
+<
+    typename Generator,
+    typename... Generators
+>
+tuple_generator<
+    Generator,
+    Generators...
+>
+tuple_of(
+    Generator gen,
+    Generators... gens
+) {
+    return tuple_generator<
+        Generator,
+        Generators...
+    >(gen, gens...);
+}
+
+/* Pick one of the given generators, with equal probability, and
+ * use it to generate (and shrink) the value.
+ */
+template
+<
+    typename Generator,
+    typename... Generators
+>
+class one_of_generator final :
+    public generator<
+        typename Generator::value_type,
+        typename Generator::engine_type
+    >
+{
+public:
+    typedef typename Generator::value_type value_type;
+    typedef typename Generator::engine_type engine_type;
+    
+    explicit
+    one_of_generator(
+        Generator gen,
+        Generators... gens
+    ) :
+        generator<
+            value_type,
+            engine_type
+        >(gen.engine()),
+        gens_(gen, gens...)
+    {
+        static_assert(
+            std::is_same<
+                std::tuple<value_type, typename Generators::value_type...>,
+                std::tuple<typename Generators::value_type..., value_type>
+            >::value,
+            "all generators must generate the same type"
+        );
+    }
+    
+    virtual value_type
+    operator()(
+        void
+    ) {
+        return this->visit_(
+            this->index(),
+            [](auto& gen) {
+                return gen();
+            },
+            std::integral_constant<std::size_t, 0>()
+        );
+    }
+    
+    std::list<value_type>
+    sample(
+        void
+    ) {
+        return this->visit_(
+            this->index(),
+            [](auto& gen) {
+                return qcxx::sample(gen);
+            },
+            std::integral_constant<std::size_t, 0>()
+        );
+    }
+    
+private:
+    static constexpr std::size_t n_gens = 1 + sizeof...(Generators);
+    
+    std::size_t
+    index(
+        void
     ) {
-        return Container(++c.begin(), c.end());
+        std::uniform_int_distribution<std::size_t> distribution(
+            0, n_gens - 1
+        );
+        return distribution(this->engine());
     }
     
     /**
-     * %reducible()
+     * %visit_()
      * @{
      */
     template
     <
-        typename Container
+        typename Function,
+        std::size_t I
     >
-    bool
-    reducible(
-        const Container& c
-    ) {
-        return c.size() > 1;
+    auto
+    visit_(
+        const std::size_t& i,
+        Function f,
+        std::integral_constant<std::size_t, I>
+    ) -> decltype(f(std::declval<Generator&>())) {
+        if (i == I)
+            return f(std::get<I>(this->gens_));
+        return this->visit_(
+            i,
+            f,
+            std::integral_constant<std::size_t, I + 1>()
+        );
     }
     template
     <
-        typename Container,
-        typename... Args
+        typename Function
     >
-    bool
-    reducible(
-        const Container& c,
-        const Args&... cs
-    ) {
-        return this->reducible(c) && this->reducible(cs...);
+    auto
+    visit_(
+        const std::size_t& i,
+        Function f,
+        std::integral_constant<std::size_t, n_gens>
+    ) -> decltype(f(std::declval<Generator&>())) {
+        (void)i;
+        (void)f;
+        QCXX_THROW(
+            std::logic_error,
+            "qcxx::one_of_generators: index out of range"
+        );
     }
     /**
      * @}
      */
     
+    std::tuple<
+        Generator,
+        Generators...
+    > gens_;
 };
 
-#define BEGIN_PROPERTY_TYPE(_Name, ...)                                     \
-    template                                                                \
-    <                                                                       \
-        typename Engine                                                     \
-    >                                                                       \
-    class _Name :                                                           \
-        public qcxx::property<                                              \
-            Engine,                                                         \
-            __VA_ARGS__                                                     \
-        >                                                                   \
-    {                                                                       \
-    public:                                                                 \
-        explicit                                                            \
-        _Name(                                                              \
-            Engine& engine,                                                 \
-            qcxx::qc_config& conf                                           \
-        ) :                                                                 \
-            qcxx::property<                                                 \
-                Engine,                                                     \
-                __VA_ARGS__                                                 \
-            >(engine, conf)                                                 \
-        {}
-
-#define END_PROPERTY_TYPE                                                   \
-    };
-
-#define PROPERTY_METHOD(...)                                                \
-    virtual qcxx::result                                                    \
-    test(                                                                   \
-        __VA_ARGS__                                                         \
-    )
-
 template
 <
-    template
-    <
-        typename
-    >
-    class Property,
-    typename RandomEngine = std::mt19937,
-    typename RandomDevice = std::random_device
+    typename Generator,
+    typename... Generators
 >
-result
-quickCheckWith(
-    qc_config& conf,
-    std::ostream& out
-) {
-    typedef RandomEngine engine_type;
-    typedef RandomDevice device_type;
-    
-    typedef Property<
-        engine_type
-    > property_type;
-    
-    device_type device;
-    engine_type engine(device());
-    
-    property_type prop(engine, conf);
-    
-    return prop.go(out);
-}
-
-template
-<
-    template
-    <
-        typename
-    >
-    class Property,
-    typename RandomEngine = std::mt19937,
-    typename RandomDevice = std::random_device
+one_of_generator<
+    Generator,
+    Generators...
 >
-result
-quickCheck(
-    void
+one_of_generators(
+    Generator gen,
+    Generators... gens
 ) {
-    qc_config conf;
-    
-    return quickCheckWith<
-        Property,
-        RandomEngine,
-        RandomDevice
-    >(conf, std::cout);
+    return one_of_generator<
+        Generator,
+        Generators...
+    >(gen, gens...);
 }
 
-/* Get a random element.
- */
-/**
- * %oneof()
- * @{
+/* Generate vectors of exactly %n values. The length is kept
+ * when shrinking, all elements are shrunk at the same time.
  */
 template
 <
-    typename Engine,
-    typename Iterator
+    typename Generator
 >
-Iterator
-oneof(
-    Engine& engine,
-    Iterator begin,
-    Iterator end
-) {
-    auto gen = get_generator<typename std::iterator_traits<
-        Iterator
-    >::difference_type>(engine);
+class vector_generator final :
+    public generator<
+        std::vector<typename Generator::value_type>,
+        typename Generator::engine_type
+    >
+{
+public:
+    typedef std::vector<
+        typename Generator::value_type
+    > value_type;
+    typedef typename Generator::engine_type engine_type;
     
-    std::advance(begin, gen(0, std::distance(begin, end) - 1));
+    explicit
+    vector_generator(
+        const std::size_t& n,
+        Generator gen
+    ) :
+        generator<
+            value_type,
+            engine_type
+        >(gen.engine()),
+        n_(n),
+        gen_(gen)
+    {}
     
-    return begin;
-}
+    virtual value_type
+    operator()(
+        void
+    ) {
+        value_type xs;
+        xs.reserve(this->n_);
+        for (std::size_t i = 0; i < this->n_; ++i)
+            xs.push_back(this->gen_());
+        return xs;
+    }
+    
+    std::list<value_type>
+    sample(
+        void
+    ) {
+        typedef std::list<
+            typename Generator::value_type
+        > list_type;
+        
+        std::vector<list_type> xs;
+        std::vector<typename list_type::const_iterator> is;
+        std::size_t m = 1;
+        
+        xs.reserve(this->n_);
+        is.reserve(this->n_);
+        for (std::size_t i = 0; i < this->n_; ++i) {
+            xs.push_back(qcxx::sample(this->gen_));
+            is.push_back(xs.back().cbegin());
+            m = std::max(m, xs.back().size());
+        }
+        
+        std::list<value_type> ys;
+        for (std::size_t k = 0; k < m; ++k) {
+            value_type y;
+            y.reserve(this->n_);
+            for (std::size_t i = 0; i < this->n_; ++i) {
+                y.push_back(*is[i]);
+                zip_advance_(is[i], xs[i]);
+            }
+            ys.push_back(std::move(y));
+        }
+        return ys;
+    }
+    
+private:
+    std::size_t n_;
+    Generator gen_;
+};
+
 template
 <
-    typename Engine,
-    typename Container
+    typename Generator
 >
-typename Container::iterator
-oneof(
-    Engine& engine,
-    Container& container
+vector_generator<
+    Generator
+>
+vector_of(
+    const std::size_t& n,
+    Generator gen
 ) {
-    return oneof(engine, container.begin(), container.end());
+    return vector_generator<
+        Generator
+    >(n, gen);
 }
-/**
- * @}
- */
 
-/* Get a random weighted value.
+/* Generate recursive values, such as trees, with at most a
+ * given number of nodes. %Builder is called as
+ * %build(gen, fuel) and must build a node of at most %fuel
+ * nodes, generating its subtrees with %gen.node() from the
+ * budgets returned by %gen.split(fuel, max_children). The
+ * size of every value, and thus the time to generate it, is
+ * then bounded by %max_nodes. Shrinking uses the minimizer of
+ * %Type, usually a %subtree_minimizer.
  */
 template
 <
     typename Type,
     typename Engine,
-    template
-    <
-        typename
-    >
-    class Container
+    typename Builder
 >
-Type
-frequency(
-    Engine& engine,
-    const Container<std::pair<
-        size_type,
-        Type
-    >>& xs
-) {
-    auto gen = get_generator<size_type>(engine);
-    auto sum = std::accumulate(
-        xs.begin(),
-        xs.end(),
-        static_cast<size_type>(0),
-        [](
-            const auto& a,
-            const auto& b
-        ) {
-            return a + b.first;
-        }
-    );
+class recursive_generator final :
+    public generator<
+        Type,
+        Engine
+    >
+{
+public:
     
-    auto n = gen(0, sum);
+    explicit
+    recursive_generator(
+        Engine& engine,
+        const size_type& max_nodes,
+        Builder build
+    ) :
+        generator<
+            Type,
+            Engine
+        >(engine),
+        max_nodes_(std::max<size_type>(max_nodes, 1)),
+        build_(build)
+    {}
     
-    for (auto x : xs) {
-        if (n <= x.first)
-            return x.second;
+    /* A value of up to %max_nodes nodes, the budget is drawn
+     * uniformly so that small values are as likely as big ones.
+     */
+    virtual Type
+    operator()(
+        void
+    ) {
+        std::uniform_int_distribution<size_type> d(1, this->max_nodes_);
+        return this->node(d(this->engine()));
     }
     
-    QCXX_THROW(
-        std::logic_error,
-        "qcxx::frequency: failed to to pick something"
-    );
+    /* A value of at most %fuel nodes, %fuel being at least one.
+     */
+    Type
+    node(
+        const size_type& fuel
+    ) {
+        return this->build_(*this, fuel);
+    }
+    
+    /* Share the budget of a node of %fuel nodes, less the node
+     * itself, between one to %max_children subtrees. Every
+     * budget is at least one, and they add up to %fuel - 1, so
+     * a value built only from them has exactly %fuel nodes.
+     */
+    std::vector<size_type>
+    split(
+        const size_type& fuel,
+        const size_type& max_children
+    ) {
+        std::vector<size_type> fs;
+        if (fuel < 2 || !max_children)
+            return fs;
+        
+        auto rest = fuel - 1;
+        std::uniform_int_distribution<size_type> dk(
+            1, std::min(max_children, rest));
+        auto k = dk(this->engine());
+        
+        std::uniform_int_distribution<size_type> dc(0, rest - k);
+        fs.reserve(k + 1);
+        fs.push_back(0);
+        for (size_type i = 1; i < k; ++i)
+            fs.push_back(dc(this->engine()));
+        fs.push_back(rest - k);
+        std::sort(fs.begin(), fs.end());
+        for (size_type i = 0; i < k; ++i)
+            fs[i] = fs[i + 1] - fs[i] + 1;
+        fs.pop_back();
+        return fs;
+    }
+    
+private:
+    size_type max_nodes_;
+    Builder build_;
+};
+
+template
+<
+    typename Type,
+    typename Engine,
+    typename Builder
+>
+recursive_generator<
+    Type,
+    Engine,
+    Builder
+>
+recursive(
+    Engine& engine,
+    const size_type& max_nodes,
+    Builder build
+) {
+    return recursive_generator<
+        Type,
+        Engine,
+        Builder
+    >(engine, max_nodes, build);
 }
 
 /* Note: Unless you know exactly what you are doing it is
  * probably wise to not use QCXX_SKIP_*; they can cause large
  * amounts of headache.
+ *
+ * Define QCXX_EDGE_ARBITRARY_TYPES to generate edge biased
+ * numbers, see %edge_numeric_generator, for all arbitrary
+ * numeric types, including the elements of containers.
  */
 
 #ifndef QCXX_SKIP_DEFAULT_ARBITRARY_TYPES
 #ifndef QCXX_SKIP_INTEGRAL_ARBITRARY_TYPES
+#ifdef QCXX_EDGE_ARBITRARY_TYPES
+ARBITRARY_TYPE(edge_integral_generator, char);
+ARBITRARY_TYPE(edge_integral_generator, signed char);
+ARBITRARY_TYPE(edge_integral_generator, unsigned char);
+ARBITRARY_TYPE(edge_integral_generator, signed short int);
+ARBITRARY_TYPE(edge_integral_generator, unsigned short int);
+ARBITRARY_TYPE(edge_integral_generator, signed int);
+ARBITRARY_TYPE(edge_integral_generator, unsigned int);
+ARBITRARY_TYPE(edge_integral_generator, signed long int);
+ARBITRARY_TYPE(edge_integral_generator, unsigned long int);
+ARBITRARY_TYPE(edge_integral_generator, signed long long int);
+ARBITRARY_TYPE(edge_integral_generator, unsigned long long int);
+#else
 ARBITRARY_TYPE(uniform_integral_generator, char);
 ARBITRARY_TYPE(uniform_integral_generator, signed char);
 ARBITRARY_TYPE(uniform_integral_generator, unsigned char);
@@ -1102,6 +10670,7 @@ ARBITRARY_TYPE(uniform_integral_generator, signed long int);
 ARBITRARY_TYPE(uniform_integral_generator, unsigned long int);
 ARBITRARY_TYPE(uniform_integral_generator, signed long long int);
 ARBITRARY_TYPE(uniform_integral_generator, unsigned long long int);
+#endif
 SHRINK_TYPE(integral_minimizer, char);
 SHRINK_TYPE(integral_minimizer, signed char);
 SHRINK_TYPE(integral_minimizer, unsigned char);
@@ -1115,8 +10684,13 @@ SHRINK_TYPE(integral_minimizer, signed long long int);
 SHRINK_TYPE(integral_minimizer, unsigned long long int);
 #endif
 #ifndef QCXX_SKIP_REAL_ARBITRARY_TYPES
+#ifdef QCXX_EDGE_ARBITRARY_TYPES
+ARBITRARY_TYPE(edge_real_generator, float);
+ARBITRARY_TYPE(edge_real_generator, double);
+#else
 ARBITRARY_TYPE(uniform_real_generator, float);
 ARBITRARY_TYPE(uniform_real_generator, double);
+#endif
 SHRINK_TYPE(real_minimizer, float);
 SHRINK_TYPE(real_minimizer, double);
 #endif
@@ -1138,16 +10712,169 @@ SHRINK_TYPE(container_minimizer, std::list<double>);
 SHRINK_TYPE(container_minimizer, std::vector<float>);
 SHRINK_TYPE(container_minimizer, std::vector<double>);
 #endif
+#ifndef QCXX_SKIP_BYTES_ARBITRARY_TYPES
+ARBITRARY_TYPE(bytes_generator, std::string);
+ARBITRARY_TYPE(bytes_generator, std::vector<std::uint8_t>);
+SHRINK_TYPE(bytes_minimizer, std::string);
+SHRINK_TYPE(bytes_minimizer, std::vector<std::uint8_t>);
+
+template
+<
+    std::size_t N,
+    typename Engine
+>
+class arbitrary<
+    std::array<std::uint8_t, N>,
+    Engine
+> {
+public:
+    typedef bytes_generator<
+        std::array<std::uint8_t, N>,
+        Engine
+    > generator_type;
+};
+
+template
+<
+    std::size_t N,
+    typename Engine
+>
+class shrink<
+    std::array<std::uint8_t, N>,
+    Engine
+> {
+public:
+    typedef bytes_minimizer<
+        std::array<std::uint8_t, N>,
+        Engine
+    > minimizer_type;
+};
+#endif
+#endif
+
+#ifndef QCXX_SKIP_DEFAULT_ENUMERABLE_TYPES
+ENUMERABLE_TYPE(integral_enumerator, char);
+ENUMERABLE_TYPE(integral_enumerator, signed char);
+ENUMERABLE_TYPE(integral_enumerator, unsigned char);
+ENUMERABLE_TYPE(integral_enumerator, signed short int);
+ENUMERABLE_TYPE(integral_enumerator, unsigned short int);
+ENUMERABLE_TYPE(integral_enumerator, signed int);
+ENUMERABLE_TYPE(integral_enumerator, unsigned int);
+ENUMERABLE_TYPE(integral_enumerator, signed long int);
+ENUMERABLE_TYPE(integral_enumerator, unsigned long int);
+ENUMERABLE_TYPE(integral_enumerator, signed long long int);
+ENUMERABLE_TYPE(integral_enumerator, unsigned long long int);
+ENUMERABLE_TYPE(container_enumerator, std::list<signed int>);
+ENUMERABLE_TYPE(container_enumerator, std::list<unsigned int>);
+ENUMERABLE_TYPE(container_enumerator, std::vector<signed int>);
+ENUMERABLE_TYPE(container_enumerator, std::vector<unsigned int>);
 #endif
 
 #ifndef QCXX_SKIP_DEFAULT_SHOWABLE_TYPES
+SHOWABLE_TYPE(signed char, show_numeric);
+SHOWABLE_TYPE(unsigned char, show_numeric);
 SHOWABLE_TYPE(std::list<signed int>, show_container);
 SHOWABLE_TYPE(std::list<unsigned int>, show_container);
 SHOWABLE_TYPE(std::vector<signed int>, show_container);
 SHOWABLE_TYPE(std::vector<unsigned int>, show_container);
+SHOWABLE_TYPE(std::list<float>, show_container);
+SHOWABLE_TYPE(std::list<double>, show_container);
+SHOWABLE_TYPE(std::vector<float>, show_container);
+SHOWABLE_TYPE(std::vector<double>, show_container);
+SHOWABLE_TYPE(std::vector<std::uint8_t>, show_container);
 #endif
 
 } // qcxx
 
+/* Replace the global operator new and delete to track
+ * allocations, see %qcxx::alloc_scope. Define
+ * QCXX_ALLOC_TRACKER in exactly one translation unit of the
+ * program before including this header.
+ */
+#ifdef QCXX_ALLOC_TRACKER
+static const bool qcxx_alloc_tracker_installed_ = (
+    qcxx::alloc_tracker_installed_() = true
+);
+
+void*
+operator new(
+    std::size_t n
+) {
+    auto p = qcxx::tracked_alloc_(n);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void*
+operator new[](
+    std::size_t n
+) {
+    return operator new(n);
+}
+
+void*
+operator new(
+    std::size_t n,
+    const std::nothrow_t&
+) noexcept {
+    return qcxx::tracked_alloc_(n);
+}
+
+void*
+operator new[](
+    std::size_t n,
+    const std::nothrow_t&
+) noexcept {
+    return qcxx::tracked_alloc_(n);
+}
+
+void
+operator delete(
+    void* p
+) noexcept {
+    qcxx::tracked_free_(p);
+}
+
+void
+operator delete[](
+    void* p
+) noexcept {
+    qcxx::tracked_free_(p);
+}
+
+void
+operator delete(
+    void* p,
+    std::size_t
+) noexcept {
+    qcxx::tracked_free_(p);
+}
+
+void
+operator delete[](
+    void* p,
+    std::size_t
+) noexcept {
+    qcxx::tracked_free_(p);
+}
+
+void
+operator delete(
+    void* p,
+    const std::nothrow_t&
+) noexcept {
+    qcxx::tracked_free_(p);
+}
+
+void
+operator delete[](
+    void* p,
+    const std::nothrow_t&
+) noexcept {
+    qcxx::tracked_free_(p);
+}
+#endif
+
 #endif
 
@@ -30,8 +30,14 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define QCXX_ALLOC_TRACKER
 #include <qcxx.hpp>
 
+#include <climits>
+#include <deque>
+#include <fstream>
+#include <set>
+
 #define PROPERTY_TYPE_GEN_IN_INTERVAL(_Name, _Type)                         \
     BEGIN_PROPERTY_TYPE(                                                    \
         _Name,                                                              \
@@ -54,6 +60,30 @@ PROPERTY_TYPE_GEN_IN_INTERVAL(prop_GenUnsignedIntInInterval, unsigned int)
 PROPERTY_TYPE_GEN_IN_INTERVAL(prop_GenFloatInInterval, float)
 PROPERTY_TYPE_GEN_IN_INTERVAL(prop_GenDoubleInInterval, double)
 
+template
+<
+    typename Type
+>
+Type
+magnitude(
+    const Type& x,
+    typename std::enable_if<std::is_signed<Type>::value>::type* = nullptr
+) {
+    return std::abs(x);
+}
+
+template
+<
+    typename Type
+>
+Type
+magnitude(
+    const Type& x,
+    typename std::enable_if<!std::is_signed<Type>::value>::type* = nullptr
+) {
+    return x;
+}
+
 #define PROPERTY_TYPE_SHRINK_TO_ZERO(_Name, _Type)                          \
     BEGIN_PROPERTY_TYPE(                                                    \
         _Name,                                                              \
@@ -68,7 +98,7 @@ PROPERTY_TYPE_GEN_IN_INTERVAL(prop_GenDoubleInInterval, double)
         if (ys.empty() || *ys.begin() != x || *ys.rbegin() != 0)            \
             return qcxx::TEST_FAILURE;                                      \
         for (auto i = ++ys.begin(); i != ys.end(); ++i) {                   \
-            if (std::abs(*i) > std::abs(y))                                 \
+            if (magnitude(*i) > magnitude(y))                               \
                 return qcxx::TEST_FAILURE;                                  \
             y = *i;                                                         \
         }                                                                   \
@@ -88,8 +118,7 @@ BEGIN_PROPERTY_TYPE(
 ) PROPERTY_METHOD(
     std::list<int> xs
 ) {
-    if (xs.empty())
-        return qcxx::TEST_DISCARD;
+    DISCARD_IF(xs.empty());
     
     auto ys = qcxx::get_minimizer<std::list<int>>(this->engine())(xs);
     auto y = ys.begin();
@@ -115,12 +144,14 @@ END_PROPERTY_TYPE
 BEGIN_PROPERTY_TYPE(
     prop_OneofList,
     std::list<int>
-) PROPERTY_METHOD(
+) PROPERTY_PRECONDITION(
+    const std::list<int>& xs
+) {
+    return !xs.empty();
+}
+PROPERTY_METHOD(
     std::list<int> xs
 ) {
-    if (xs.empty())
-        return qcxx::TEST_DISCARD;
-    
     auto x = std::find(
         xs.begin(),
         xs.end(),
@@ -131,26 +162,2684 @@ BEGIN_PROPERTY_TYPE(
 }
 END_PROPERTY_TYPE
 
-int main(int argc, char* argv[])
+BEGIN_PROPERTY_TYPE(
+    prop_NonNegative,
+    signed int
+) PROPERTY_METHOD(
+    signed int x
+) {
+    return x >= 0;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_NoByteFF,
+    std::string
+) PROPERTY_METHOD(
+    std::string s
+) {
+    return s.find('\xff') == std::string::npos;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_JsonlReportRecord,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf;
+    conf.seed = seed;
+    conf.fixed_seed = true;
+    
+    std::ostringstream osstr;
+    auto r = qcxx::TEST_NOTHING;
+    {
+        qcxx::jsonl_reporter rep(osstr);
+        r = qcxx::quickCheckWith<prop_NonNegative>(conf, rep);
+    }
+    auto s = osstr.str();
+    
+    /* Bytes of invalid UTF-8 are escaped, valid UTF-8 is kept.
+     * Some seeds take more than the default number of tests to
+     * draw a byte 0xff.
+     */
+    qcxx::qc_config conf1;
+    conf1.seed = seed;
+    conf1.fixed_seed = true;
+    conf1.max_tests = 1000;
+    std::ostringstream out1;
+    qcxx::jsonl_reporter rep1(out1);
+    auto r1 = qcxx::quickCheckWith<prop_NoByteFF>(conf1, rep1);
+    rep1.flush();
+    auto s1 = out1.str();
+    std::string s2;
+    qcxx::jsonl_reporter::quote(s2, "\xc3\xa9\xff\xed\xa0\x80");
+    
+    return (
+        r == qcxx::TEST_FAILURE &&
+        std::count(s.begin(), s.end(), '\n') == 1 &&
+        s.back() == '\n' &&
+        s.find("\"property\":\"prop_NonNegative\"") != std::string::npos &&
+        s.find("\"status\":\"failure\"") != std::string::npos &&
+        s.find("\"seed\":" + std::to_string(seed) + ",") != std::string::npos &&
+        s.find("\"counterexample\":[\"-") != std::string::npos &&
+        r1 == qcxx::TEST_FAILURE &&
+        s1.find("\\u00ff") != std::string::npos &&
+        s1.find('\xff') == std::string::npos &&
+        s2 == "\"\xc3\xa9\\u00ff\\u00ed\\u00a0\\u0080\""
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ShowContainerTruncated,
+    std::vector<int>
+) PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    qcxx::show_config conf;
+    conf.head = 3;
+    conf.tail = 2;
+    
+    std::ostringstream osstr;
+    qcxx::show_container(osstr, xs, conf);
+    auto s = osstr.str();
+    auto commas = std::count(s.begin(), s.end(), ',');
+    
+    if (xs.size() <= conf.head + conf.tail) {
+        return (
+            s.find("...") == std::string::npos &&
+            commas == static_cast<long>(xs.empty()? 0: xs.size() - 1)
+        );
+    }
+    
+    /* Containers of different types dump to different files.
+     */
+    qcxx::show_config dump = conf;
+    dump.dump_prefix = "qcxx-dump";
+    std::ostringstream out0;
+    std::ostringstream out1;
+    qcxx::show_container(out0, xs, dump);
+    qcxx::show_container(out1, std::list<int>(xs.begin(), xs.end()), dump);
+    auto dumped = [](const std::string& shown) {
+        const std::string marker = "full value in ";
+        auto i = shown.find(marker);
+        if (i == std::string::npos)
+            return std::make_pair(std::string(), std::string());
+        i += marker.size();
+        auto path = shown.substr(i, shown.find(')', i) - i);
+        std::ifstream file(path);
+        std::ostringstream value;
+        value << file.rdbuf();
+        std::remove(path.c_str());
+        return std::make_pair(path, value.str());
+    };
+    auto dump0 = dumped(out0.str());
+    auto dump1 = dumped(out1.str());
+    qcxx::show_config full;
+    full.head = xs.size();
+    std::ostringstream expected;
+    qcxx::show_container(expected, xs, full);
+    
+    return (
+        s.find(std::to_string(xs.back()) + "] (" +
+            std::to_string(xs.size()) + " elements)") != std::string::npos &&
+        commas == static_cast<long>(conf.head + conf.tail) &&
+        !dump0.first.empty() &&
+        dump0.first != dump1.first &&
+        dump0.second == expected.str() &&
+        dump1.second == expected.str()
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_WeightedChoiceSkipsZeroWeights,
+    std::vector<unsigned int>
+) PROPERTY_METHOD(
+    std::vector<unsigned int> ws
+) {
+    std::vector<std::pair<qcxx::size_type, std::size_t>> xs;
+    for (std::size_t i = 0; i < ws.size(); ++i)
+        xs.push_back(std::make_pair(ws[i] % 4, i));
+    
+    if (std::none_of(xs.begin(), xs.end(), [](const auto& x) {
+        return x.first != 0;
+    }))
+        return qcxx::TEST_DISCARD;
+    
+    qcxx::weighted_choice<std::size_t> choice(xs);
+    
+    for (auto n = 0; n < 256; ++n) {
+        auto i = choice(this->engine());
+        if (i >= xs.size() || xs[i].first == 0)
+            return qcxx::TEST_FAILURE;
+    }
+    
+    return qcxx::TEST_SUCCESS;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_FrequencyPicksByWeight,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int w
+) {
+    w = w % 8 + 1;
+    
+    std::list<std::pair<qcxx::size_type, char>> xs = {
+        std::make_pair(w, 'a'),
+        std::make_pair(0u, 'b'),
+        std::make_pair(8u, 'c')
+    };
+    std::map<char, unsigned int> n;
+    for (auto i = 0; i < 4096; ++i)
+        n[qcxx::frequency(this->engine(), xs)]++;
+    
+    auto expected = 4096.0 * w / (w + 8);
+    
+    return (
+        n['b'] == 0 &&
+        std::abs(n['a'] - expected) < 0.25 * expected
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_GeneratorsSatisfyPreconditions,
+    signed int,
+    std::vector<int>
+) PROPERTY_GENERATORS(
+    qcxx::such_that(
+        [](const int& x) {
+            return x % 2 == 0;
+        },
+        qcxx::arbitrary_of<int>(this->engine())
+    ),
+    qcxx::vector_of(
+        4,
+        qcxx::one_of_generators(
+            qcxx::elements(this->engine(), {1, 2, 3}),
+            qcxx::map(
+                [](const unsigned char& x) {
+                    return x % 3 + 1;
+                },
+                qcxx::arbitrary_of<unsigned char>(this->engine())
+            )
+        )
+    )
+) PROPERTY_METHOD(
+    signed int x,
+    std::vector<int> xs
+) {
+    return (
+        x % 2 == 0 &&
+        xs.size() == 4 &&
+        std::all_of(xs.begin(), xs.end(), [](const int& y) {
+            return 1 <= y && y <= 3;
+        })
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_EvenBelowThousand,
+    signed int
+) PROPERTY_GENERATORS(
+    qcxx::such_that(
+        [](const int& x) {
+            return x % 2 == 0;
+        },
+        qcxx::arbitrary_of<int>(this->engine())
+    )
+) PROPERTY_METHOD(
+    signed int x
+) {
+    return x < 1000;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ShrinkThroughGenerators,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf;
+    conf.seed = seed;
+    conf.fixed_seed = true;
+    
+    std::ostringstream osstr;
+    qcxx::text_reporter rep(osstr);
+    
+    typedef prop_EvenBelowThousand<std::mt19937> property_type;
+    std::mt19937 engine(seed);
+    property_type prop(engine, conf);
+    
+    if (prop.go(rep) != qcxx::TEST_FAILURE)
+        return qcxx::TEST_FAILURE;
+    
+    auto x = std::stoi(prop.last_report().counterexample.at(0));
+    
+    auto ys = qcxx::sample(qcxx::tuple_of(
+        qcxx::map(
+            [](const int& y) {
+                return y / 2 * 2;
+            },
+            qcxx::arbitrary_of<int>(this->engine())
+        ),
+        qcxx::elements(this->engine(), {'a', 'b', 'c'})
+    ));
+    
+    return (
+        x % 2 == 0 &&
+        x >= 1000 &&
+        std::get<0>(ys.back()) == 0 &&
+        std::get<1>(ys.back()) == 'a' &&
+        std::all_of(ys.begin(), ys.end(), [](const auto& y) {
+            return std::get<0>(y) % 2 == 0;
+        })
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_MultipleOfEight,
+    unsigned int
+) PROPERTY_PRECONDITION(
+    const unsigned int& x
+) {
+    return x % 8 == 0;
+}
+PROPERTY_METHOD(
+    unsigned int x
+) {
+    return x % 8 == 0;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_NeverSmall,
+    unsigned char
+) PROPERTY_METHOD(
+    unsigned char x
+) {
+    DISCARD_IF(x > 1);
+    return qcxx::TEST_DISCARD;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_DiscardSites,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    conf1.max_discards = 64;
+    conf1.enumerate = qcxx::ENUMERATE_NEVER;
+    
+    std::ostringstream osstr;
+    qcxx::text_reporter rep(osstr);
+    
+    qcxx::qc_config conf2 = conf0;
+    conf2.max_retries = 1;
+    conf2.max_discards = 16;
+#ifdef QCXX_HAVE_FORK
+    conf2.isolate = true;
+#endif
+    
+    auto r0 = qcxx::quickCheckWith<prop_MultipleOfEight>(conf0, rep);
+    auto r1 = qcxx::quickCheckWith<prop_NeverSmall>(conf1, rep);
+    qcxx::quickCheckWith<prop_MultipleOfEight>(conf2, rep);
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        conf0.n_rejects > 0 &&
+        r1 == qcxx::TEST_DISCARD &&
+        conf1.discard_sites["x > 1"] + conf1.discard_sites["test"] == 64 &&
+        conf1.discard_sites["x > 1"] > conf1.discard_sites["test"] &&
+        conf2.discard_sites["precondition"] == conf2.n_discards &&
+        conf2.n_discards > 0
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_NotQ,
+    char
+) PROPERTY_METHOD(
+    char c
+) {
+    return c != 'q';
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ShortSum,
+    std::vector<int>,
+    unsigned char
+) PROPERTY_METHOD(
+    std::vector<int> xs,
+    unsigned char y
+) {
+    return std::accumulate(xs.begin(), xs.end(), 0) + y < 258;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_DistinctBytes,
+    unsigned char,
+    unsigned char
+) PROPERTY_METHOD(
+    unsigned char x,
+    unsigned char y
+) {
+    if (x == y)
+        throw qcxx::discarded("equal");
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ExhaustiveEnumeration,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int n_threads
+) {
+    qcxx::qc_config conf0;
+    conf0.n_threads = n_threads % 8;
+    
+    qcxx::qc_config conf1;
+    conf1.enumerate = qcxx::ENUMERATE_ALWAYS;
+    conf1.depth = 2;
+    conf1.n_threads = n_threads % 8;
+    
+    std::ostringstream osstr;
+    qcxx::jsonl_reporter rep(osstr);
+    
+    auto r0 = qcxx::quickCheckWith<prop_NotQ>(conf0, rep);
+    auto r1 = qcxx::quickCheckWith<prop_ShortSum>(conf1, rep);
+    
+    qcxx::qc_config conf2;
+    conf2.n_threads = n_threads % 8;
+    auto r2 = qcxx::quickCheckWith<prop_DistinctBytes>(conf2, rep);
+    
+    // Reals are not enumerable, so they can not always be.
+    qcxx::qc_config conf3;
+    conf3.enumerate = qcxx::ENUMERATE_ALWAYS;
+    auto refused = false;
+    try {
+        qcxx::quickCheckWith<prop_GenDoubleInInterval>(conf3, rep);
+    } catch (const std::logic_error&) {
+        refused = true;
+    }
+    
+    /* Vectors are enumerated as [], [0], [-1], [1], [-2], [2],
+     * [0, 0], [-1, 0], ... so the first failing values are [2, 1]
+     * and 255, after 20 vectors times 256 values of y and 255
+     * more values of y.
+     */
+    return (
+        r0 == qcxx::TEST_FAILURE &&
+        osstr.str().find("\"exhaustive\":true,\"counterexample\":[\"q\"]")
+            != std::string::npos &&
+        r1 == qcxx::TEST_FAILURE &&
+        osstr.str().find("[\"[2, 1]\",\"255\"]") != std::string::npos &&
+        conf1.n_tests == 20 * 256 + 255 &&
+        r2 == qcxx::TEST_SUCCESS &&
+        conf2.n_tests == 256 * 255 &&
+        conf2.discard_sites["equal"] == 256 &&
+        refused &&
+        conf3.n_tests == 0
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ClassifyListLengths,
+    std::vector<int>
+) PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    this->classify(xs.size() < 8, "short");
+    this->cover(50, xs.size() >= 8, "long");
+    this->collect(xs.size() / 32);
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_CoverZero,
+    signed int
+) PROPERTY_METHOD(
+    signed int x
+) {
+    this->cover(10, x == 0, "zero");
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_InsufficientCoverage,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf;
+    conf.seed = seed;
+    conf.fixed_seed = true;
+    
+    std::ostringstream osstr;
+    qcxx::text_reporter rep(osstr);
+    
+    return (
+        qcxx::quickCheckWith<prop_CoverZero>(conf, rep) == qcxx::TEST_FAILURE &&
+        conf.n_tests == conf.max_tests &&
+        osstr.str().find("zero (required 10%)") != std::string::npos
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_EdgeCasesGenerated,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    std::mt19937 engine(seed);
+    qcxx::edge_integral_generator<int, std::mt19937> ints(engine);
+    qcxx::edge_real_generator<double, std::mt19937> reals(engine);
+    
+    std::set<int> is;
+    auto nan = false;
+    auto inf = false;
+    auto negative_zero = false;
+    auto subnormal = false;
+    
+    for (auto n = 0; n < 8192; ++n) {
+        is.insert(ints());
+        
+        auto x = reals();
+        nan = nan || std::isnan(x);
+        inf = inf || std::isinf(x);
+        negative_zero = negative_zero || (x == 0 && std::signbit(x));
+        subnormal = subnormal || std::fpclassify(x) == FP_SUBNORMAL;
+        
+        auto y = ints(-10, 10);
+        if (y < -10 || y > 10)
+            return qcxx::TEST_FAILURE;
+    }
+    
+    return (
+        is.count(0) && is.count(1) && is.count(-1) &&
+        is.count(std::numeric_limits<int>::min()) &&
+        is.count(std::numeric_limits<int>::max()) &&
+        nan && inf && negative_zero && subnormal
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_GenDoubleFinite,
+    double
+) PROPERTY_METHOD(
+    double x
+) {
+    this->classify(x < 0, "negative");
+    this->cover(25, x > 0, "positive");
+    return std::isfinite(x);
+}
+END_PROPERTY_TYPE
+
+struct tree
+{
+    int value;
+    std::vector<tree> children;
+};
+
+std::ostream&
+operator<<(
+    std::ostream& out,
+    const tree& t
+) {
+    out << '[' << t.value;
+    for (const auto& c : t.children)
+        out << ' ' << c;
+    return out << ']';
+}
+
+template
+<
+    typename Engine
+>
+auto
+tree_generator(
+    Engine& engine,
+    const qcxx::size_type& max_nodes
+) {
+    return qcxx::recursive<tree>(
+        engine,
+        max_nodes,
+        [](auto& gen, const qcxx::size_type& fuel) {
+            tree t;
+            t.value = qcxx::get_generator<int>(gen.engine())();
+            for (auto f : gen.split(fuel, 3))
+                t.children.push_back(gen.node(f));
+            return t;
+        }
+    );
+}
+
+template
+<
+    typename Type,
+    typename Engine
+>
+class arbitrary_tree_generator :
+    public qcxx::generator<
+        Type,
+        Engine
+    >
 {
-    (void)argc;
-    (void)argv;
+public:
     
-    qcxx::quickCheck<prop_GenSignedIntInInterval>();
-    qcxx::quickCheck<prop_GenUnsignedIntInInterval>();
+    explicit
+    arbitrary_tree_generator(
+        Engine& engine
+    ) :
+        qcxx::generator<
+            Type,
+            Engine
+        >(engine)
+    {}
     
-    qcxx::quickCheck<prop_GenFloatInInterval>();
-    qcxx::quickCheck<prop_GenDoubleInInterval>();
+    virtual Type
+    operator()(
+        void
+    ) {
+        return tree_generator(this->engine(), 64)();
+    }
     
-    qcxx::quickCheck<prop_ShrinkSignedInt>();
-    qcxx::quickCheck<prop_ShrinkUnsignedInt>();
+};
+
+template
+<
+    typename Engine
+>
+class qcxx::arbitrary<
+    tree,
+    Engine
+> {
+public:
+    typedef arbitrary_tree_generator<
+        tree,
+        Engine
+    > generator_type;
+};
+
+template
+<
+    typename Engine
+>
+class qcxx::shrink<
+    tree,
+    Engine
+> {
+public:
+    typedef qcxx::subtree_minimizer<
+        tree,
+        Engine
+    > minimizer_type;
+};
+
+template
+<
+>
+class qcxx::subtrees<
+    tree
+> {
+public:
+    typedef std::vector<tree> container_type;
     
-    qcxx::quickCheck<prop_ShrinkFloat>();
-    qcxx::quickCheck<prop_ShrinkDouble>();
+    static container_type*
+    of(
+        tree& x
+    ) {
+        return &x.children;
+    }
     
-    qcxx::quickCheck<prop_GenAndShrinkList>();
+    static const container_type*
+    of(
+        const tree& x
+    ) {
+        return &x.children;
+    }
+};
+
+BEGIN_PROPERTY_TYPE(
+    prop_TreeNodeBudget,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    std::mt19937 engine(seed);
+    auto gen = tree_generator(engine, 16);
     
-    qcxx::quickCheck<prop_OneofList>();
+    std::set<std::size_t> sizes;
+    for (auto n = 0; n < 1024; ++n) {
+        auto size = qcxx::subtree_size(gen());
+        if (size < 1 || size > 16)
+            return qcxx::TEST_FAILURE;
+        sizes.insert(size);
+    }
+    return sizes.count(1) && sizes.count(16);
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SmallTree,
+    tree
+) PROPERTY_METHOD(
+    tree t
+) {
+    return qcxx::subtree_size(t) < 3;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ShrinkTreeToSubtrees,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf;
+    conf.seed = seed;
+    conf.fixed_seed = true;
+    
+    std::ostringstream osstr;
+    auto r = qcxx::quickCheckWith<prop_SmallTree>(conf, osstr);
+    auto s = osstr.str();
+    
+    // Walking the shrinks in place gives the same values as the
+    // list and leaves the tree as it was.
+    auto shown = [](const tree& x) {
+        std::ostringstream out;
+        out << x;
+        return out.str();
+    };
+    std::mt19937 engine(seed);
+    auto t = tree_generator(engine, 64)();
+    auto before = shown(t);
+    qcxx::subtree_minimizer<tree, std::mt19937> min(engine);
+    auto shrinks = min.shrinks(t);
+    auto i = shrinks.begin();
+    auto same = min.shrinks(t, [&](const tree& y) {
+        if (i == shrinks.end() || shown(*i++) != shown(y))
+            return false;
+        return qcxx::subtree_size(y) < qcxx::subtree_size(t);
+    });
+    
+    return (
+        r == qcxx::TEST_FAILURE &&
+        std::count(s.begin(), s.end(), '[') == 3 &&
+        same &&
+        i == shrinks.end() &&
+        shown(t) == before &&
+        min(t).back().children.empty()
+    );
+}
+END_PROPERTY_TYPE
+
+bool
+valid_utf8(
+    const std::string& s
+) {
+    for (std::size_t i = 0; i < s.size(); ) {
+        auto b = static_cast<unsigned char>(s[i]);
+        std::size_t m = b < 0x80? 1: b < 0xc2? 0: b < 0xe0? 2: b < 0xf0? 3:
+            b < 0xf5? 4: 0;
+        if (!m || i + m > s.size())
+            return false;
+        
+        auto c = m > 1? static_cast<unsigned char>(s[i + 1]): 0x80;
+        auto lo = b == 0xe0? 0xa0: b == 0xf0? 0x90: 0x80;
+        auto hi = b == 0xed? 0x9f: b == 0xf4? 0x8f: 0xbf;
+        if (c < lo || c > hi)
+            return false;
+        for (std::size_t j = 2; j < m; ++j)
+            if ((static_cast<unsigned char>(s[i + j]) & 0xc0) != 0x80)
+                return false;
+        i += m;
+    }
+    return true;
+}
+
+BEGIN_PROPERTY_TYPE(
+    prop_BytesAlphabets,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    std::mt19937_64 engine(seed);
+    qcxx::bytes_config conf;
+    conf.max_size = 4096;
+    
+    conf.chars = qcxx::ALPHABET_UTF8;
+    qcxx::bytes_generator<std::string, std::mt19937_64> utf8(engine, conf);
+    qcxx::bytes_minimizer<std::string, std::mt19937_64> min(
+        engine, utf8.config());
+    auto s = utf8();
+    auto shrinks = min(s);
+    for (const auto& x : shrinks)
+        if (!valid_utf8(x) || x.size() > s.size())
+            return qcxx::TEST_FAILURE;
+    
+    // Other alphabets are truncated anywhere.
+    qcxx::bytes_minimizer<std::vector<std::uint8_t>, std::mt19937_64> raw(
+        engine, qcxx::bytes_config());
+    auto truncated = false;
+    for (const auto& x : raw(std::vector<std::uint8_t>(8, 0x80)))
+        truncated = truncated || (!x.empty() && x.size() < 8);
+    if (!truncated)
+        return qcxx::TEST_FAILURE;
+    
+    conf.chars = qcxx::ALPHABET_PRINTABLE;
+    qcxx::bytes_generator<
+        std::vector<std::uint8_t>,
+        std::mt19937_64
+    > printable(engine, conf);
+    for (auto b : printable(1000))
+        if (b < 0x20 || b > 0x7e)
+            return qcxx::TEST_FAILURE;
+    
+    conf.chars = qcxx::ALPHABET_ASCII;
+    qcxx::bytes_generator<
+        std::array<std::uint8_t, 64>,
+        std::mt19937_64
+    > ascii(engine, conf);
+    for (auto b : ascii())
+        if (b > 0x7f)
+            return qcxx::TEST_FAILURE;
+    
+    return printable(1 << 16).size() == 1 << 16;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_BytesWithinSettings,
+    std::string,
+    std::vector<std::uint8_t>
+) PROPERTY_METHOD(
+    std::string s,
+    std::vector<std::uint8_t> xs
+) {
+    const auto& conf = qcxx::bytes_settings();
+    auto in_alphabet = [&](const unsigned char& b) {
+        return (
+            conf.chars == qcxx::ALPHABET_BYTES ||
+            conf.chars == qcxx::ALPHABET_UTF8 ||
+            (conf.chars == qcxx::ALPHABET_ASCII && b < 0x80) ||
+            (conf.chars == qcxx::ALPHABET_PRINTABLE && b >= 0x20 && b < 0x7f)
+        );
+    };
+    
+    return (
+        s.size() <= conf.max_size &&
+        xs.size() <= conf.max_size &&
+        std::all_of(s.begin(), s.end(), in_alphabet) &&
+        std::all_of(xs.begin(), xs.end(), in_alphabet) &&
+        (conf.chars != qcxx::ALPHABET_UTF8 || valid_utf8(s))
+    );
+}
+END_PROPERTY_TYPE
+
+class last_reporter :
+    public qcxx::reporter
+{
+public:
+    virtual void
+    operator()(
+        const qcxx::report& rep
+    ) {
+        this->last = rep;
+    }
+    
+    qcxx::report last;
+};
+
+BEGIN_BATCH_PROPERTY_TYPE(
+    prop_BatchAddCommutes,
+    unsigned int,
+    unsigned int
+) PROPERTY_BATCH_METHOD(
+    xs,
+    mask
+) {
+    const auto& as = std::get<0>(xs);
+    const auto& bs = std::get<1>(xs);
+    for (std::size_t i = 0; i < mask.size(); ++i)
+        mask[i] = as[i] + bs[i] == bs[i] + as[i];
+}
+END_PROPERTY_TYPE
+
+BEGIN_BATCH_PROPERTY_TYPE(
+    prop_BatchBelowLimit,
+    unsigned int
+) PROPERTY_BATCH_METHOD(
+    xs,
+    mask
+) {
+    const auto& as = std::get<0>(xs);
+    for (std::size_t i = 0; i < mask.size(); ++i)
+        mask[i] = as[i] < 1000000;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_BatchEvaluation,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.max_tests = 20000;
+    conf0.batch_size = 4096;
+    
+    qcxx::qc_config conf1 = conf0;
+    
+    qcxx::qc_config conf2;
+    conf2.batch_size = 0;
+    conf2.soak = true;
+    conf2.soak_for = std::chrono::milliseconds(5);
+    
+    last_reporter rep;
+    qcxx::null_reporter none;
+    auto r0 = qcxx::quickCheckWith<prop_BatchAddCommutes>(conf0, rep);
+    auto r2 = qcxx::quickCheckWith<prop_BatchAddCommutes>(conf2, none);
+    auto r1 = qcxx::quickCheckWith<prop_BatchBelowLimit>(conf1, rep);
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        conf0.n_tests == 20000 &&
+        r2 == qcxx::TEST_SUCCESS &&
+        conf2.n_tests > 0 &&
+        r1 == qcxx::TEST_FAILURE &&
+        conf1.n_tests < 4096 &&
+        rep.last.counterexample.size() == 1 &&
+        std::stoul(rep.last.counterexample[0]) >= 1000000
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_DIFFERENTIAL_PROPERTY_TYPE(
+    prop_SortDifferential,
+    std::vector<int>,
+    std::vector<int>
+) PROPERTY_REFERENCE(
+    const std::vector<int>& xs
+) {
+    auto ys = xs;
+    for (std::size_t i = 1; i < ys.size(); ++i)
+        for (auto j = i; j > 0 && ys[j - 1] > ys[j]; --j)
+            std::swap(ys[j - 1], ys[j]);
+    return ys;
+}
+PROPERTY_OPTIMIZED(
+    const std::vector<int>& xs
+) {
+    auto ys = xs;
+    std::sort(ys.begin(), ys.end());
+    return ys;
+}
+END_PROPERTY_TYPE
+
+BEGIN_DIFFERENTIAL_PROPERTY_TYPE(
+    prop_SumDifferential,
+    long long,
+    std::vector<int>
+) PROPERTY_REFERENCE(
+    const std::vector<int>& xs
+) {
+    return std::accumulate(xs.begin(), xs.end(), 0LL);
+}
+PROPERTY_OPTIMIZED(
+    const std::vector<int>& xs
+) {
+    return xs.size() < 4? std::accumulate(xs.begin(), xs.end(), 0LL): 0;
+}
+PROPERTY_EQUIVALENCE(
+    const long long& a,
+    const long long& b
+) {
+    return a == b || (a % 2 == 0 && b % 2 == 0);
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_DifferentialTimings,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    auto r0 = qcxx::quickCheckWith<prop_SortDifferential>(conf0, rep0);
+    
+    // Calls made while shrinking are not timed.
+    typedef prop_SumDifferential<std::mt19937> property_type;
+    std::mt19937 engine(seed);
+    property_type prop(engine, conf1);
+    prop.go(rep1);
+    
+    // Every run is timed afresh.
+    conf1.n_tests = 0;
+    conf1.n_discards = 0;
+    auto r1 = prop.go(rep1);
+    
+    std::set<std::string> names;
+    for (const auto& m : rep0.last.metrics)
+        names.insert(m.first);
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        names.count("reference_p50_ns") &&
+        names.count("optimized_p99_ns") &&
+        names.count("speedup_p50") &&
+        names.count("speedup_p99") &&
+        names.count("speedup") &&
+        r1 == qcxx::TEST_FAILURE &&
+        rep1.last.counterexample.size() == 1 &&
+        prop.reference_timings().count() == rep1.last.n_tests + 1 &&
+        prop.optimized_timings().count() == rep1.last.n_tests + 1
+    );
+}
+END_PROPERTY_TYPE
+
+class counting_reporter :
+    public qcxx::reporter
+{
+public:
+    counting_reporter(
+        void
+    ) :
+        n_reports(0)
+    {}
+    
+    virtual void
+    operator()(
+        const qcxx::report& rep
+    ) {
+        this->n_reports++;
+        this->last = rep;
+    }
+    
+    std::size_t n_reports;
+    qcxx::report last;
+};
+
+BEGIN_PROPERTY_TYPE(
+    prop_SortIsOrdered,
+    std::vector<int>
+) PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    std::sort(xs.begin(), xs.end());
+    return std::is_sorted(xs.begin(), xs.end());
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_EvenWorkload,
+    std::vector<int>
+) PROPERTY_GENERATORS(
+    qcxx::map(
+        [](std::vector<int> xs) {
+            for (auto& x : xs)
+                x = x / 2 * 2;
+            return xs;
+        },
+        qcxx::arbitrary_of<std::vector<int>>(this->engine())
+    )
+) PROPERTY_PRECONDITION(
+    const std::vector<int>& xs
+) {
+    return !xs.empty();
+}
+PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    return !xs.empty() && std::all_of(xs.begin(), xs.end(), [](int x) {
+        return x % 2 == 0;
+    });
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_NeverHolds,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int
+) {
+    return false;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_BenchmarkSweep,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::bench_config conf;
+    conf.seed = seed;
+    conf.sizes = {1, 10, 100};
+    conf.n_inputs = 8;
+    conf.n_rounds = 4;
+    
+    counting_reporter rep;
+    auto points = qcxx::benchmarkWith<prop_SortIsOrdered>(conf, rep);
+    
+    /* Workloads come from the generators of the property and
+     * satisfy its precondition.
+     */
+    qcxx::null_reporter none;
+    auto even = qcxx::benchmarkWith<prop_EvenWorkload>(conf, none);
+    
+    // Failures are counted in the timed rounds only, like tests.
+    last_reporter failed;
+    auto never = qcxx::benchmarkWith<prop_NeverHolds>(conf, failed);
+    
+    return (
+        even.size() == 3 &&
+        even[0].n_failures == 0 &&
+        even[2].n_failures == 0 &&
+        points.size() == 3 &&
+        points[2].size == 100 &&
+        points[2].mean > 0 &&
+        points[2].n_failures == 0 &&
+        rep.n_reports == 3 &&
+        rep.last.name == "prop_SortIsOrdered/100" &&
+        rep.last.status == qcxx::TEST_SUCCESS &&
+        rep.last.n_tests == 32 &&
+        rep.last.metrics.size() == 5 &&
+        never.size() == 3 &&
+        never[2].n_failures == failed.last.n_tests &&
+        failed.last.status == qcxx::TEST_FAILURE
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SortLinearithmic,
+    std::vector<int>
+) EXPECT_COMPLEXITY(
+    n log n
+)
+PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    std::sort(xs.begin(), xs.end(), [this](const int& a, const int& b) {
+        this->tally();
+        return a < b;
+    });
+    return std::is_sorted(xs.begin(), xs.end());
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_InsertionSortLinearithmic,
+    std::vector<int>
+) EXPECT_COMPLEXITY(
+    n log n
+)
+PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    for (std::size_t i = 1; i < xs.size(); ++i) {
+        for (auto j = i; j > 0 && xs[j - 1] > xs[j]; --j) {
+            this->tally();
+            std::swap(xs[j - 1], xs[j]);
+        }
+    }
+    return std::is_sorted(xs.begin(), xs.end());
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ComplexityFit,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::complexity_config conf;
+    conf.seed = seed;
+    conf.min_size = 32;
+    conf.max_size = 1024;
+    conf.n_inputs = 4;
+    conf.n_rounds = 1;
+    
+    /* Both sorts count their operations, so the fits do not
+     * depend on timing.
+     */
+    last_reporter rep;
+    auto r0 = qcxx::checkComplexityWith<prop_SortLinearithmic>(conf, rep);
+    auto fit0 = rep.last.metrics;
+    auto r1 = qcxx::checkComplexityWith<
+        prop_InsertionSortLinearithmic
+    >(conf, rep);
+    auto fit1 = rep.last.metrics;
+    auto rms = [](
+        const std::vector<std::pair<std::string, double>>& metrics,
+        const std::string& name
+    ) {
+        for (const auto& m : metrics) {
+            if (m.first == name)
+                return m.second;
+        }
+        return std::numeric_limits<double>::infinity();
+    };
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        rms(fit0, "rms_n_log_n") < rms(fit0, "rms_n^2") &&
+        rms(fit0, "tallied_1024") > 0 &&
+        r1 == qcxx::TEST_FAILURE &&
+        rms(fit1, "rms_n^2") < 0.05 &&
+        rep.last.message.find("expected O(n log n)") != std::string::npos &&
+        qcxx::complexity_of("n * n") == qcxx::COMPLEXITY_N2 &&
+        qcxx::complexity_of("log n") == qcxx::COMPLEXITY_LOG_N
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_IncrementConstant,
+    unsigned int
+) EXPECT_COMPLEXITY(
+    1
+)
+PROPERTY_METHOD(
+    unsigned int x
+) {
+    return x + 1 != x;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SizeConstant,
+    std::vector<int>
+) EXPECT_COMPLEXITY(
+    1
+)
+PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    return xs.size() + 1 != xs.size();
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SumConstant,
+    std::vector<int>
+) EXPECT_COMPLEXITY(
+    1
+)
+PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    volatile long long sum = std::accumulate(xs.begin(), xs.end(), 0LL);
+    return sum >= LLONG_MIN;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_TimedComplexityFit,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::complexity_config conf;
+    conf.seed = seed;
+    
+    /* Timed fits must not mistake noise for growth, but still
+     * tell a linear cost from a constant one.
+     */
+    qcxx::null_reporter rep0;
+    qcxx::null_reporter rep1;
+    last_reporter rep2;
+    auto r0 = qcxx::checkComplexityWith<prop_IncrementConstant>(conf, rep0);
+    auto r1 = qcxx::checkComplexityWith<prop_SizeConstant>(conf, rep1);
+    auto r2 = qcxx::checkComplexityWith<prop_SumConstant>(conf, rep2);
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        r1 == qcxx::TEST_SUCCESS &&
+        r2 == qcxx::TEST_FAILURE &&
+        rep2.last.message.find("expected O(1)") != std::string::npos
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_FewInstructions,
+    std::vector<int>
+) EXPECT_COUNTERS(
+    {qcxx::COUNTER_INSTRUCTIONS, 1}
+)
+PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    return std::accumulate(xs.begin(), xs.end(), 0LL) >= LLONG_MIN;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_CounterLimits,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf;
+    conf.seed = seed;
+    conf.fixed_seed = true;
+    
+    qcxx::perf_counters counters;
+    auto available = counters.open() &&
+        counters.available(qcxx::COUNTER_INSTRUCTIONS);
+    
+    last_reporter rep;
+    auto r = qcxx::quickCheckWith<prop_FewInstructions>(conf, rep);
+    
+    return available?
+        r == qcxx::TEST_FAILURE &&
+            rep.last.message.find("instructions") == 0 &&
+            !rep.last.metrics.empty():
+        r == qcxx::TEST_SUCCESS;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SumWithoutAllocating,
+    std::vector<int>
+) PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    auto sum = std::accumulate(xs.begin(), xs.end(), 0LL);
+    EXPECT_NO_ALLOC();
+    
+    std::vector<long long> sums(xs.size() + 1);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        sums[i + 1] = sums[i] + xs[i];
+    EXPECT_ALLOC_BYTES_LE((xs.size() + 1) * sizeof(long long));
+    
+    return sums.back() == sum;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_CopyAllocates,
+    std::vector<int>
+) PROPERTY_METHOD(
+    std::vector<int> xs
+) {
+    std::vector<int> ys(xs);
+    EXPECT_NO_ALLOC();
+    return ys == xs;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_AllocationAccounting,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.count_allocs = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    auto r0 = qcxx::quickCheckWith<prop_SumWithoutAllocating>(conf0, rep0);
+    auto r1 = qcxx::quickCheckWith<prop_CopyAllocates>(conf1, rep1);
+    
+    auto allocs_mean = -1.0;
+    for (const auto& m : rep0.last.metrics)
+        if (m.first == "allocs_mean")
+            allocs_mean = m.second;
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        allocs_mean > 0 &&
+        allocs_mean <= 1 &&
+        r1 == qcxx::TEST_FAILURE &&
+        rep1.last.counterexample.size() == 1 &&
+        rep1.last.counterexample[0] != "[]"
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SlowAboveThousand,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int x
+) {
+    while (x > 1000 && !this->timed_out())
+        std::this_thread::yield();
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_SlowEveryFourth,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int x
+) {
+    if (x % 4 == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return true;
+}
+EXPECT_LATENCY(
+    {0.5, std::chrono::milliseconds(50)},
+    {0.99, std::chrono::milliseconds(2)}
+)
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_TimeoutsAndLatency,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.timeout = std::chrono::milliseconds(10);
+    
+    qcxx::qc_config conf1;
+    conf1.seed = seed;
+    conf1.fixed_seed = true;
+    conf1.max_tests = 64;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    
+    auto r0 = qcxx::quickCheckWith<prop_SlowAboveThousand>(conf0, rep0);
+    auto r1 = qcxx::quickCheckWith<prop_SlowEveryFourth>(conf1, rep1);
+    
+    auto p99 = 0.0;
+    for (const auto& m : rep1.last.metrics)
+        if (m.first == "test_p99_ns")
+            p99 = m.second;
+    
+    /* Sleeps only bound times from below, so the limits leave
+     * wide margins around both the fast and the slow tests.
+     */
+    return (
+        r0 == qcxx::TEST_FAILURE &&
+        rep0.last.message.find("timeout") != std::string::npos &&
+        rep0.last.counterexample.size() == 1 &&
+        std::stoul(rep0.last.counterexample[0]) > 1000 &&
+        r1 == qcxx::TEST_FAILURE &&
+        rep1.last.message.compare(0, 4, "p99 ") == 0 &&
+        p99 > 2e6
+    );
+}
+END_PROPERTY_TYPE
+
+#ifdef QCXX_HAVE_FORK
+BEGIN_PROPERTY_TYPE(
+    prop_CrashAboveThousand,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int x
+) {
+    if (x > 1000)
+        std::abort();
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ThrowAboveThousand,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int x
+) {
+    if (x > 1000)
+        throw std::runtime_error("too large");
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_EvenLabels,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int x
+) {
+    this->classify(x % 2 == 0, "even");
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_IsolatedCrash,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.isolate = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    qcxx::qc_config conf2 = conf0;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    last_reporter rep2;
+    
+    auto r0 = qcxx::quickCheckWith<prop_CrashAboveThousand>(conf0, rep0);
+    auto r1 = qcxx::quickCheckWith<prop_EvenLabels>(conf1, rep1);
+    auto r2 = qcxx::quickCheckWith<prop_ThrowAboveThousand>(conf2, rep2);
+    
+    return (
+        r1 == qcxx::TEST_SUCCESS &&
+        rep1.last.n_tests == conf1.max_tests &&
+        rep1.last.labels.size() == 1 &&
+        rep1.last.labels[0].first == "even" &&
+        r0 == qcxx::TEST_FAILURE &&
+        rep0.last.message.find("signal") != std::string::npos &&
+        rep0.last.counterexample.size() == 1 &&
+        std::stoul(rep0.last.counterexample[0]) > 1000 &&
+        r2 == qcxx::TEST_FAILURE &&
+        rep2.last.message == "caught exception: too large" &&
+        rep2.last.counterexample.size() == 1 &&
+        std::stoul(rep2.last.counterexample[0]) > 1000
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ShardedWorkers,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.n_workers = 4;
+    conf0.max_tests = 101;
+    
+    qcxx::qc_config conf1 = conf0;
+    conf1.n_workers = 3;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    
+    auto r0 = qcxx::quickCheckWith<prop_EvenLabels>(conf0, rep0);
+    auto r1 = qcxx::quickCheckWith<prop_CrashAboveThousand>(conf1, rep1);
+    qcxx::size_type n_even = 0;
+    for (const auto& l : rep0.last.labels)
+        n_even += l.second;
+    
+    qcxx::qc_config conf2;
+    const char* args[] = {
+        "main", "--verbose", "--qcxx-seed=42", "--qcxx-max-tests=7",
+        "--qcxx-workers=2", "--qcxx-isolate", "--qcxx-timeout-ms=5"
+    };
+    int argc = 7;
+    qcxx::configure(argc, const_cast<char**>(args), conf2);
+    auto rejected = [](const char* arg) {
+        const char* args[] = {"main", arg};
+        qcxx::qc_config conf;
+        int argc = 2;
+        try {
+            qcxx::configure(argc, const_cast<char**>(args), conf);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        rep0.last.n_tests == conf0.max_tests &&
+        n_even > 0 && n_even < rep0.last.n_tests &&
+        r1 == qcxx::TEST_FAILURE &&
+        rep1.last.message.find("signal") != std::string::npos &&
+        rep1.last.counterexample.size() == 1 &&
+        std::stoul(rep1.last.counterexample[0]) > 1000 &&
+        conf2.seed == 42 &&
+        conf2.fixed_seed &&
+        conf2.max_tests == 7 &&
+        conf2.n_workers == 2 &&
+        conf2.isolate &&
+        conf2.timeout == std::chrono::milliseconds(5) &&
+        argc == 2 &&
+        std::string(args[1]) == "--verbose" &&
+        !args[2] &&
+        rejected("--qcxx-bogus") &&
+        rejected("--qcxx-workers=two") &&
+        rejected("--qcxx-seed=")
+    );
+}
+END_PROPERTY_TYPE
+#endif
+
+struct sorted_index
+{
+    explicit
+    sorted_index(
+        std::mt19937& engine
+    ) :
+        keys(256),
+        n_queries(0)
+    {
+        n_built++;
+        std::uniform_int_distribution<int> key(-1000, 1000);
+        for (auto& k : keys)
+            k = key(engine);
+        std::sort(keys.begin(), keys.end());
+    }
+    
+    void
+    reset(
+        void
+    ) {
+        n_queries = 0;
+    }
+    
+    std::vector<int> keys;
+    int n_queries;
+    
+    static std::atomic<int> n_built;
+};
+
+std::atomic<int> sorted_index::n_built(0);
+
+BEGIN_FIXTURE_PROPERTY_TYPE(
+    prop_FixtureIndex,
+    sorted_index,
+    signed short int
+) PROPERTY_METHOD(
+    signed short int x
+) {
+    auto& index = this->fixture();
+    if (index.n_queries++)
+        return false;
+    
+    return (
+        std::binary_search(index.keys.begin(), index.keys.end(), x) ==
+        (std::find(index.keys.begin(), index.keys.end(), x) != index.keys.end())
+    );
+}
+END_PROPERTY_TYPE
+
+struct slow_reset
+{
+    void
+    reset(
+        void
+    ) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+};
+
+BEGIN_FIXTURE_PROPERTY_TYPE(
+    prop_SlowReset,
+    slow_reset,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int
+) {
+    this->fixture();
+    return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_FixtureSetupOnce,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.enumerate = qcxx::ENUMERATE_NEVER;
+    
+    qcxx::qc_config conf1 = conf0;
+    conf1.enumerate = qcxx::ENUMERATE_ALWAYS;
+    conf1.depth = 512;
+    conf1.n_threads = 4;
+    
+    qcxx::null_reporter rep;
+    
+    sorted_index::n_built = 0;
+    auto r0 = qcxx::quickCheckWith<prop_FixtureIndex>(conf0, rep);
+    auto n0 = sorted_index::n_built.load();
+    
+    sorted_index::n_built = 0;
+    auto r1 = qcxx::quickCheckWith<prop_FixtureIndex>(conf1, rep);
+    auto n1 = sorted_index::n_built.load();
+    
+    // Resetting the fixture does not count towards the timeout.
+    qcxx::qc_config conf2;
+    conf2.seed = seed;
+    conf2.fixed_seed = true;
+    conf2.max_tests = 4;
+    conf2.timeout = std::chrono::milliseconds(10);
+    auto r2 = qcxx::quickCheckWith<prop_SlowReset>(conf2, rep);
+    
+    // Nor towards the time of a benchmark.
+    qcxx::bench_config conf3;
+    conf3.seed = seed;
+    conf3.sizes = {1};
+    conf3.n_inputs = 2;
+    conf3.n_rounds = 1;
+    auto points = qcxx::benchmarkWith<prop_SlowReset>(conf3, rep);
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        n0 == 1 &&
+        r1 == qcxx::TEST_SUCCESS &&
+        conf1.n_tests > conf0.max_tests &&
+        n1 == 4 &&
+        r2 == qcxx::TEST_SUCCESS &&
+        points.size() == 1 &&
+        points[0].mean < 1e7
+    );
+}
+END_PROPERTY_TYPE
+
+struct queue_command
+{
+    enum {
+        PUSH = 0,
+        POP = 1,
+        SIZE = 2
+    };
+    
+    int op;
+    int value;
+};
+
+std::ostream&
+operator<<(
+    std::ostream& out,
+    const queue_command& c
+) {
+    switch (c.op) {
+    case queue_command::PUSH:
+        return out << "push(" << c.value << ")";
+    case queue_command::POP:
+        return out << "pop";
+    default:
+        return out << "size";
+    }
+}
+
+/* A queue of at most four values. With %Buggy, its size is
+ * zero when it is full.
+ */
+template
+<
+    bool Buggy
+>
+class ring_buffer
+{
+public:
+    ring_buffer(
+        void
+    ) :
+        values_(),
+        head_(0),
+        n_(0)
+    {}
+    
+    void
+    push(
+        int x
+    ) {
+        this->values_[(this->head_ + this->n_) % 4] = x;
+        this->n_++;
+    }
+    
+    int
+    pop(
+        void
+    ) {
+        auto x = this->values_[this->head_];
+        this->head_ = (this->head_ + 1) % 4;
+        this->n_--;
+        return x;
+    }
+    
+    std::size_t
+    size(
+        void
+    ) const {
+        return Buggy? this->n_ % 4: this->n_;
+    }
+    
+private:
+    std::array<int, 4> values_;
+    std::size_t head_;
+    std::size_t n_;
+};
+
+typedef ring_buffer<false> good_ring;
+typedef ring_buffer<true> buggy_ring;
+
+template
+<
+    typename Queue
+>
+long long
+run_queue(
+    Queue& q,
+    const queue_command& c
+) {
+    switch (c.op) {
+    case queue_command::PUSH:
+        q.push(c.value);
+        return 0;
+    case queue_command::POP:
+        return q.pop();
+    default:
+        return static_cast<long long>(q.size());
+    }
+}
+
+long long
+next_queue(
+    std::deque<int>& model,
+    const queue_command& c
+) {
+    switch (c.op) {
+    case queue_command::PUSH:
+        model.push_back(c.value);
+        return 0;
+    case queue_command::POP: {
+        auto x = model.front();
+        model.pop_front();
+        return x;
+    }
+    default:
+        return static_cast<long long>(model.size());
+    }
+}
+
+bool
+queue_allowed(
+    const std::deque<int>& model,
+    const queue_command& c
+) {
+    return (
+        c.op == queue_command::PUSH? model.size() < 4:
+        c.op == queue_command::POP? !model.empty():
+        true
+    );
+}
+
+template
+<
+    typename Type,
+    typename Engine
+>
+class queue_command_generator :
+    public qcxx::generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    queue_command_generator(
+        Engine& engine
+    ) :
+        qcxx::generator<
+            Type,
+            Engine
+        >(engine)
+    {}
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        std::uniform_int_distribution<int> op(0, 3);
+        std::uniform_int_distribution<int> value(-100, 100);
+        
+        queue_command c;
+        c.op = std::max<int>(op(this->engine()) - 1, queue_command::PUSH);
+        c.value = value(this->engine());
+        return c;
+    }
+    
+};
+
+template
+<
+    typename Engine
+>
+class qcxx::arbitrary<
+    queue_command,
+    Engine
+> {
+public:
+    typedef queue_command_generator<
+        queue_command,
+        Engine
+    > generator_type;
+};
+
+BEGIN_STATEFUL_PROPERTY_TYPE(
+    prop_RingBufferModel,
+    std::deque<int>,
+    good_ring,
+    queue_command,
+    long long
+) PROPERTY_ALLOWED(
+    const std::deque<int>& model,
+    const queue_command& c
+) {
+    return queue_allowed(model, c);
+}
+PROPERTY_RUN(
+    good_ring& q,
+    const queue_command& c
+) {
+    return run_queue(q, c);
+}
+PROPERTY_NEXT(
+    std::deque<int>& model,
+    const queue_command& c
+) {
+    return next_queue(model, c);
+}
+END_PROPERTY_TYPE
+
+BEGIN_STATEFUL_PROPERTY_TYPE(
+    prop_BuggyRingBuffer,
+    std::deque<int>,
+    buggy_ring,
+    queue_command,
+    long long
+) PROPERTY_ALLOWED(
+    const std::deque<int>& model,
+    const queue_command& c
+) {
+    return queue_allowed(model, c);
+}
+PROPERTY_RUN(
+    buggy_ring& q,
+    const queue_command& c
+) {
+    return run_queue(q, c);
+}
+PROPERTY_NEXT(
+    std::deque<int>& model,
+    const queue_command& c
+) {
+    return next_queue(model, c);
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ShrinkCommandSequence,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    conf1.max_tests = 4;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    
+    auto r0 = qcxx::quickCheckWith<prop_BuggyRingBuffer>(conf0, rep0);
+    
+    auto max_size = qcxx::commands_settings().max_size;
+    qcxx::commands_settings().max_size = 10000;
+    auto r1 = qcxx::quickCheckWith<prop_RingBufferModel>(conf1, rep1);
+    qcxx::commands_settings().max_size = max_size;
+    
+    if (r0 != qcxx::TEST_FAILURE || rep0.last.counterexample.size() != 1)
+        return false;
+    
+    std::istringstream in(rep0.last.counterexample[0]);
+    std::string command;
+    std::size_t n_pushes = 0;
+    std::size_t n_commands = 0;
+    while (in >> command) {
+        n_pushes += command.compare(0, 5, "[push") == 0 ||
+            command.compare(0, 4, "push") == 0;
+        n_commands++;
+    }
+    
+    return (
+        n_pushes == 4 &&
+        n_commands == 5 &&
+        r1 == qcxx::TEST_SUCCESS
+    );
+}
+END_PROPERTY_TYPE
+
+struct counter_command
+{
+    bool get;
+};
+
+std::ostream&
+operator<<(
+    std::ostream& out,
+    const counter_command& c
+) {
+    return out << (c.get? "get": "inc");
+}
+
+long
+next_counter(
+    long& n,
+    const counter_command& c
+) {
+    return c.get? n: ++n;
+}
+
+struct atomic_counter
+{
+    atomic_counter(
+        void
+    ) :
+        n(0)
+    {}
+    
+    long
+    run(
+        const counter_command& c
+    ) {
+        return c.get? this->n.load(): ++this->n;
+    }
+    
+    std::atomic<long> n;
+};
+
+/* A counter whose increments are a load and a store, so that
+ * concurrent increments may be lost. It only switches threads
+ * at its yield points, which makes the race deterministic
+ * under %qcxx::pct_scheduler.
+ */
+struct scheduled_counter
+{
+    scheduled_counter(
+        void
+    ) :
+        n(0)
+    {}
+    
+    long
+    run(
+        const counter_command& c
+    ) {
+        if (c.get)
+            return this->n.load();
+        auto v = this->n.load();
+        this->n.store(v + 1);
+        return v + 1;
+    }
+    
+    qcxx::yielding_atomic<long> n;
+};
+
+struct locked_counter
+{
+    locked_counter(
+        void
+    ) :
+        n(0)
+    {}
+    
+    long
+    run(
+        const counter_command& c
+    ) {
+        std::lock_guard<qcxx::yielding_mutex> lock(this->mutex);
+        if (c.get)
+            return this->n;
+        auto v = this->n;
+        qcxx::yield_point();
+        return this->n = v + 1;
+    }
+    
+    qcxx::yielding_mutex mutex;
+    long n;
+};
+
+template
+<
+    typename Type,
+    typename Engine
+>
+class counter_command_generator :
+    public qcxx::generator<
+        Type,
+        Engine
+    >
+{
+public:
+    
+    explicit
+    counter_command_generator(
+        Engine& engine
+    ) :
+        qcxx::generator<
+            Type,
+            Engine
+        >(engine)
+    {}
+    
+    virtual Type
+    operator()(
+        void
+    ) {
+        std::uniform_int_distribution<int> op(0, 3);
+        counter_command c;
+        c.get = op(this->engine()) == 0;
+        return c;
+    }
+    
+};
+
+template
+<
+    typename Engine
+>
+class qcxx::arbitrary<
+    counter_command,
+    Engine
+> {
+public:
+    typedef counter_command_generator<
+        counter_command,
+        Engine
+    > generator_type;
+};
+
+BEGIN_CONCURRENT_PROPERTY_TYPE(
+    prop_AtomicCounter,
+    long,
+    atomic_counter,
+    counter_command,
+    long
+) PROPERTY_RUN(
+    atomic_counter& counter,
+    const counter_command& c
+) {
+    return counter.run(c);
+}
+PROPERTY_NEXT(
+    long& n,
+    const counter_command& c
+) {
+    return next_counter(n, c);
+}
+END_PROPERTY_TYPE
+
+BEGIN_CONCURRENT_PROPERTY_TYPE(
+    prop_ScheduledCounter,
+    long,
+    scheduled_counter,
+    counter_command,
+    long
+) PROPERTY_RUN(
+    scheduled_counter& counter,
+    const counter_command& c
+) {
+    return counter.run(c);
+}
+PROPERTY_NEXT(
+    long& n,
+    const counter_command& c
+) {
+    return next_counter(n, c);
+}
+END_PROPERTY_TYPE
+
+BEGIN_CONCURRENT_PROPERTY_TYPE(
+    prop_LockedCounter,
+    long,
+    locked_counter,
+    counter_command,
+    long
+) PROPERTY_RUN(
+    locked_counter& counter,
+    const counter_command& c
+) {
+    return counter.run(c);
+}
+PROPERTY_NEXT(
+    long& n,
+    const counter_command& c
+) {
+    return next_counter(n, c);
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_LinearizableHistories,
+    unsigned short int
+) PROPERTY_METHOD(
+    unsigned short int t
+) {
+    typedef qcxx::operation<counter_command, long> op;
+    
+    const counter_command inc = {false};
+    const counter_command get = {true};
+    auto check = [](const std::vector<op>& history) {
+        return qcxx::linearizable(
+            0L,
+            history,
+            next_counter,
+            [](const counter_command&, long a, long b) {
+                return a == b;
+            }
+        );
+    };
+    
+    return (
+        !check({{inc, 1, t + 0u, t + 3u}, {inc, 1, t + 1u, t + 2u}}) &&
+        check({{inc, 2, t + 0u, t + 3u}, {inc, 1, t + 1u, t + 2u}}) &&
+        !check({{inc, 2, t + 0u, t + 1u}, {inc, 1, t + 2u, t + 3u}}) &&
+        check({{inc, 1, t + 0u, t + 3u}, {get, 0, t + 1u, t + 2u}}) &&
+        check({})
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ConcurrentCounters,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    
+    qcxx::null_reporter rep0;
+    qcxx::null_reporter rep1;
+    
+    // Whether the operating system exposes a race is up to its
+    // scheduler, see prop_ScheduledInterleavings instead.
+    auto r0 = qcxx::quickCheckWith<prop_AtomicCounter>(conf0, rep0);
+    
+    auto settings = qcxx::parallel_settings();
+    qcxx::parallel_settings().n_threads = 4;
+    qcxx::parallel_settings().max_size = 32;
+    auto r1 = qcxx::quickCheckWith<prop_AtomicCounter>(conf1, rep1);
+    
+    typedef qcxx::parallel_commands<counter_command> history_type;
+    std::mt19937 engine(seed);
+    qcxx::parallel_commands_generator<history_type, std::mt19937> gen(
+        engine);
+    auto longest = std::size_t(0);
+    for (auto i = 0; i < 16; ++i)
+        for (const auto& t : gen())
+            longest = std::max(longest, t.size());
+    
+    qcxx::parallel_settings().n_threads = 65;
+    auto rejected = false;
+    try {
+        qcxx::parallel_commands_generator<history_type, std::mt19937> g(
+            engine);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    qcxx::parallel_settings() = settings;
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        r1 == qcxx::TEST_SUCCESS &&
+        longest <= 64 / 4 &&
+        rejected
+    );
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_ScheduledInterleavings,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.max_tests = 1000;
+    
+    qcxx::qc_config conf1 = conf0;
+    qcxx::qc_config conf2 = conf0;
+    
+    last_reporter rep0;
+    last_reporter rep1;
+    qcxx::null_reporter rep2;
+    
+    auto scheduled = qcxx::parallel_settings().scheduled;
+    qcxx::parallel_settings().scheduled = true;
+    auto r0 = qcxx::quickCheckWith<prop_ScheduledCounter>(conf0, rep0);
+    auto r1 = qcxx::quickCheckWith<prop_ScheduledCounter>(conf1, rep1);
+    auto r2 = qcxx::quickCheckWith<prop_LockedCounter>(conf2, rep2);
+    qcxx::parallel_settings().scheduled = scheduled;
+    
+    typedef qcxx::parallel_commands<counter_command> history_type;
+    history_type x(2);
+    x.schedule.priorities = {1, 0};
+    x.schedule.preemptions = {4, 6};
+    std::mt19937 engine(seed);
+    qcxx::parallel_commands_minimizer<history_type, std::mt19937> shr(
+        engine);
+    auto sorted = true;
+    for (const auto& y : shr.shrinks(x))
+        sorted = sorted && std::is_sorted(
+            y.schedule.preemptions.begin(), y.schedule.preemptions.end());
+    
+    return (
+        r0 == qcxx::TEST_FAILURE &&
+        rep0.last.counterexample.size() == 1 &&
+        rep0.last.counterexample[0].find("preemptions") !=
+            std::string::npos &&
+        r1 == qcxx::TEST_FAILURE &&
+        rep1.last.counterexample == rep0.last.counterexample &&
+        r2 == qcxx::TEST_SUCCESS &&
+        sorted
+    );
+}
+END_PROPERTY_TYPE
+
+#ifdef QCXX_HAVE_COROUTINES
+struct async_counts
+{
+    static std::size_t in_flight;
+    static std::size_t max_in_flight;
+};
+
+std::size_t async_counts::in_flight = 0;
+std::size_t async_counts::max_in_flight = 0;
+
+BEGIN_ASYNC_PROPERTY_TYPE(
+    prop_AsyncSleep,
+    unsigned short int
+) PROPERTY_ASYNC_METHOD(
+    unsigned short int us
+) {
+    auto& loop = qcxx::event_loop::current();
+    auto start = loop.now();
+    async_counts::max_in_flight = std::max(
+        async_counts::max_in_flight, ++async_counts::in_flight);
+    co_await loop.sleep_for(std::chrono::microseconds(us));
+    async_counts::in_flight--;
+    co_return loop.now() - start == std::chrono::microseconds(us);
+}
+END_PROPERTY_TYPE
+
+BEGIN_ASYNC_PROPERTY_TYPE(
+    prop_AsyncSlowAboveMinute,
+    unsigned int
+) PROPERTY_ASYNC_METHOD(
+    unsigned int s
+) {
+    co_await qcxx::event_loop::current().sleep_for(std::chrono::seconds(s));
+    co_return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_ASYNC_PROPERTY_TYPE(
+    prop_AsyncStallAboveThousand,
+    unsigned int
+) PROPERTY_ASYNC_METHOD(
+    unsigned int x
+) {
+    if (x > 1000)
+        co_await std::suspend_always();
+    co_return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_ASYNC_PROPERTY_TYPE(
+    prop_AsyncThrowAboveThousand,
+    unsigned int
+) PROPERTY_ASYNC_METHOD(
+    unsigned int x
+) {
+    co_await qcxx::event_loop::current().sleep_for(std::chrono::seconds(1));
+    if (x > 1000)
+        throw std::runtime_error("too large");
+    co_return true;
+}
+END_PROPERTY_TYPE
+
+BEGIN_PROPERTY_TYPE(
+    prop_AsyncProperties,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    
+    qcxx::qc_config conf1 = conf0;
+    qcxx::qc_config conf2 = conf0;
+    qcxx::qc_config conf3 = conf0;
+    
+    qcxx::null_reporter rep0;
+    last_reporter rep1;
+    last_reporter rep2;
+    last_reporter rep3;
+    
+    async_counts::max_in_flight = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto r0 = qcxx::quickCheckWith<prop_AsyncSleep>(conf0, rep0);
+    auto r1 = qcxx::quickCheckWith<prop_AsyncSlowAboveMinute>(conf1, rep1);
+    auto r2 = qcxx::quickCheckWith<prop_AsyncStallAboveThousand>(
+        conf2, rep2);
+    auto r3 = qcxx::quickCheckWith<prop_AsyncThrowAboveThousand>(
+        conf3, rep3);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        async_counts::in_flight == 0 &&
+        async_counts::max_in_flight > 1 &&
+        r1 == qcxx::TEST_FAILURE &&
+        rep1.last.counterexample.size() == 1 &&
+        std::stoul(rep1.last.counterexample[0]) > 60 &&
+        rep1.last.message.find("virtual time") != std::string::npos &&
+        r2 == qcxx::TEST_FAILURE &&
+        rep2.last.counterexample.size() == 1 &&
+        std::stoul(rep2.last.counterexample[0]) > 1000 &&
+        rep2.last.message.find("never completed") != std::string::npos &&
+        r3 == qcxx::TEST_FAILURE &&
+        rep3.last.counterexample.size() == 1 &&
+        std::stoul(rep3.last.counterexample[0]) > 1000 &&
+        rep3.last.message.find("too large") != std::string::npos &&
+        elapsed < std::chrono::seconds(5)
+    );
+}
+END_PROPERTY_TYPE
+#endif
+
+std::vector<unsigned int> soaked_values;
+
+BEGIN_PROPERTY_TYPE(
+    prop_RecordValues,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int x
+) {
+    soaked_values.push_back(x);
+    this->label(x % 2? "odd": "even");
+    return true;
+}
+END_PROPERTY_TYPE
+
+/* Keep the checkpoint as it was at the first progress report,
+ * as if the run had been killed right after it.
+ */
+class checkpoint_reporter :
+    public last_reporter
+{
+public:
+    explicit
+    checkpoint_reporter(
+        const std::string& path
+    ) :
+        path(path),
+        n_progress(0),
+        n_tests(0),
+        checkpoint()
+    {}
+    
+    virtual void
+    progress(
+        const qcxx::report& rep
+    ) {
+        if (!this->n_progress++) {
+            std::ifstream in(this->path, std::ios::binary);
+            std::ostringstream osstr;
+            osstr << in.rdbuf();
+            this->checkpoint = osstr.str();
+            this->n_tests = rep.n_tests;
+        }
+    }
+    
+    std::string path;
+    qcxx::size_type n_progress;
+    qcxx::size_type n_tests;
+    std::string checkpoint;
+};
+
+BEGIN_PROPERTY_TYPE(
+    prop_SoakAndResume,
+    unsigned int
+) PROPERTY_METHOD(
+    unsigned int seed
+) {
+    const auto path = "qcxx-checkpoint-" + std::to_string(seed);
+    
+    qcxx::qc_config conf0;
+    conf0.seed = seed;
+    conf0.fixed_seed = true;
+    conf0.soak = true;
+    conf0.soak_for = std::chrono::milliseconds(20);
+    conf0.progress_every = std::chrono::milliseconds(2);
+    conf0.checkpoint = path;
+    
+    checkpoint_reporter rep0(path);
+    soaked_values.clear();
+    auto r0 = qcxx::quickCheckWith<prop_RecordValues>(conf0, rep0);
+    auto values = soaked_values;
+    auto removed = !std::ifstream(path).is_open();
+    
+    std::ofstream(path, std::ios::binary) << rep0.checkpoint;
+    qcxx::qc_config conf1;
+    conf1.max_tests = rep0.n_tests + 64;
+    conf1.checkpoint = path;
+    
+    last_reporter rep1;
+    soaked_values.clear();
+    auto r1 = qcxx::quickCheckWith<prop_RecordValues>(conf1, rep1);
+    std::vector<unsigned int> resumed(
+        values.begin() + std::min<std::size_t>(rep0.n_tests, values.size()),
+        values.begin() + std::min<std::size_t>(rep0.n_tests + 64,
+            values.size())
+    );
+    auto replayed = soaked_values == resumed;
+    qcxx::size_type n_labelled = 0;
+    for (const auto& l : rep1.last.labels)
+        n_labelled += l.second;
+    
+    // A checkpoint taken at the end still reports its result.
+    std::ofstream(path, std::ios::binary) << rep0.checkpoint;
+    qcxx::qc_config conf4;
+    conf4.max_tests = rep0.n_tests;
+    conf4.checkpoint = path;
+    last_reporter rep4;
+    auto r4 = qcxx::quickCheckWith<prop_RecordValues>(conf4, rep4);
+    
+    // Soak runs allow max_discards per max_tests passed, pro rata.
+    qcxx::qc_config conf5;
+    conf5.soak = true;
+    conf5.n_tests = 100;
+    conf5.n_discards = 1823;
+    auto within = conf5.again();
+    conf5.n_discards++;
+    auto beyond = !conf5.again();
+    
+    qcxx::qc_config conf2;
+    conf2.soak = true;
+    conf2.soak_for = std::chrono::milliseconds(5);
+    conf2.progress_every = std::chrono::milliseconds(1);
+    std::ostringstream out2;
+    auto r2 = qcxx::quickCheckWith<prop_BatchAddCommutes>(conf2, out2);
+    
+    qcxx::qc_config conf3;
+    conf3.soak = true;
+    conf3.soak_for = std::chrono::milliseconds(200);
+    conf3.progress_every = std::chrono::milliseconds(20);
+    conf3.n_workers = 2;
+    std::ostringstream out3;
+    auto r3 = qcxx::quickCheckWith<prop_RecordValues>(conf3, out3);
+    
+    return (
+        r0 == qcxx::TEST_SUCCESS &&
+        rep0.n_progress > 1 &&
+        !rep0.checkpoint.empty() &&
+        removed &&
+        r1 == qcxx::TEST_SUCCESS &&
+        rep1.last.n_tests == rep0.n_tests + 64 &&
+        rep1.last.seed == seed &&
+        replayed &&
+        n_labelled == rep1.last.n_tests &&
+        !std::ifstream(path).is_open() &&
+        r2 == qcxx::TEST_SUCCESS &&
+        out2.str().find(": running, ") != std::string::npos &&
+        out2.str().find("tests_per_s: ") != std::string::npos &&
+        r3 == qcxx::TEST_SUCCESS &&
+        out3.str().find(": running, ") != std::string::npos &&
+        r4 == qcxx::TEST_SUCCESS &&
+        rep4.last.n_tests == rep0.n_tests &&
+        within &&
+        beyond
+    );
+}
+END_PROPERTY_TYPE
+
+int main(int argc, char* argv[])
+{
+    qcxx::configure(argc, argv);
+    
+    qcxx::quickCheck<prop_GenSignedIntInInterval>();
+    qcxx::quickCheck<prop_GenUnsignedIntInInterval>();
+    
+    qcxx::quickCheck<prop_GenFloatInInterval>();
+    qcxx::quickCheck<prop_GenDoubleInInterval>();
+    qcxx::quickCheck<prop_GenDoubleFinite>();
+    qcxx::quickCheck<prop_EdgeCasesGenerated>();
+    
+    qcxx::quickCheck<prop_ShrinkSignedInt>();
+    qcxx::quickCheck<prop_ShrinkUnsignedInt>();
+    
+    qcxx::quickCheck<prop_ShrinkFloat>();
+    qcxx::quickCheck<prop_ShrinkDouble>();
+    
+    qcxx::quickCheck<prop_GenAndShrinkList>();
+    
+    qcxx::quickCheck<prop_OneofList>();
+    qcxx::quickCheck<prop_DiscardSites>();
+    qcxx::quickCheck<prop_ExhaustiveEnumeration>();
+    qcxx::quickCheck<prop_ClassifyListLengths>();
+    qcxx::quickCheck<prop_InsufficientCoverage>();
+    
+    qcxx::quickCheck<prop_WeightedChoiceSkipsZeroWeights>();
+    qcxx::quickCheck<prop_FrequencyPicksByWeight>();
+    
+    qcxx::quickCheck<prop_GeneratorsSatisfyPreconditions>();
+    qcxx::quickCheck<prop_ShrinkThroughGenerators>();
+    
+    qcxx::quickCheck<prop_TreeNodeBudget>();
+    qcxx::quickCheck<prop_ShrinkTreeToSubtrees>();
+    
+    qcxx::quickCheck<prop_BytesAlphabets>();
+    qcxx::quickCheck<prop_BytesWithinSettings>();
+    qcxx::bytes_settings().chars = qcxx::ALPHABET_PRINTABLE;
+    qcxx::quickCheck<prop_BytesWithinSettings>();
+    qcxx::bytes_settings().chars = qcxx::ALPHABET_UTF8;
+    qcxx::quickCheck<prop_BytesWithinSettings>();
+    qcxx::bytes_settings().chars = qcxx::ALPHABET_BYTES;
+    
+    qcxx::quickCheck<prop_BatchEvaluation>();
+    qcxx::quickCheck<prop_DifferentialTimings>();
+    qcxx::quickCheck<prop_BenchmarkSweep>();
+    qcxx::quickCheck<prop_CounterLimits>();
+    qcxx::quickCheck<prop_AllocationAccounting>();
+    
+    qcxx::quickCheck<prop_RingBufferModel>();
+    qcxx::quickCheck<prop_ShrinkCommandSequence>();
+    qcxx::quickCheck<prop_LinearizableHistories>();
+#ifdef QCXX_HAVE_COROUTINES
+    qcxx::quickCheck<prop_AsyncProperties>();
+#endif
+    
+    qcxx::qc_config few;
+    few.max_tests = 8;
+    qcxx::quickCheckWith<prop_TimeoutsAndLatency>(few, std::cout);
+    qcxx::qc_config concurrent;
+    concurrent.max_tests = 4;
+    qcxx::quickCheckWith<prop_ConcurrentCounters>(concurrent, std::cout);
+    qcxx::qc_config interleavings;
+    interleavings.max_tests = 8;
+    qcxx::quickCheckWith<prop_ScheduledInterleavings>(
+        interleavings, std::cout);
+    
+    qcxx::qc_config fixtures;
+    fixtures.max_tests = 16;
+    qcxx::quickCheckWith<prop_FixtureSetupOnce>(fixtures, std::cout);
+    
+#ifdef QCXX_HAVE_FORK
+    qcxx::qc_config isolated;
+    isolated.max_tests = 8;
+    qcxx::quickCheckWith<prop_IsolatedCrash>(isolated, std::cout);
+    qcxx::qc_config sharded;
+    sharded.max_tests = 4;
+    qcxx::quickCheckWith<prop_ShardedWorkers>(sharded, std::cout);
+#endif
+    
+    qcxx::qc_config soaks;
+    soaks.max_tests = 4;
+    qcxx::quickCheckWith<prop_SoakAndResume>(soaks, std::cout);
+    
+    qcxx::qc_config once;
+    once.max_tests = 4;
+    qcxx::quickCheckWith<prop_ComplexityFit>(once, std::cout);
+    qcxx::qc_config timed;
+    timed.max_tests = 4;
+    qcxx::quickCheckWith<prop_TimedComplexityFit>(timed, std::cout);
+    
+    qcxx::quickCheck<prop_JsonlReportRecord>();
+    qcxx::quickCheck<prop_ShowContainerTruncated>();
     
     return 0;
 }